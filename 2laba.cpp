@@ -22,975 +22,8476 @@
 #include <stdexcept>
 #include <cstring>
 #include <cstdlib>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <new>
+#include <memory_resource>
+#include <string>
+#include <charconv>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <type_traits>
+#include <limits>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC 12 ложно считает неинициализированным результат _mm512_undefined_pd()
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#define POLY_PERF_EVENTS
+#endif
 
 /**
- * @defgroup PolynomialClass Класс Polynomial
- * @brief Основной класс для работы с квадратными полиномами
- * @{
+ * @struct RootCalculationRecord
+ * @brief Двоичная запись об одном вычислении корней
+ * @details Запись фиксированного размера; текст формируется только при выводе
+ * статистики (см. Polynomial::formatRootCalculation())
  */
+struct RootCalculationRecord {
+    std::uint64_t sequence; ///< Порядковый номер вычисления
+    double a;               ///< Коэффициент при x²
+    double b;               ///< Коэффициент при x
+    double c;               ///< Свободный член
+    double root1;           ///< Первый корень (если существует)
+    double root2;           ///< Второй корень (если существует)
+    int numRoots;           ///< Количество действительных корней
+};
 
 /**
- * @class Polynomial
- * @brief Класс для представления квадратного полинома вида ax² + bx + c
- * Класс инкапсулирует коэффициенты квадратного полинома и предоставляет:
- * - Арифметические операции (+, -, *, /, +=, -=, *=, /=)
- * - Операции инкремента/декремента (++, --)
- * - Операции сравнения (<, >, <=, >=, ==, !=)
- * - Вычисление корней уравнения
- * - Вычисление значения полинома в точке
- * - Статистику использования класса
+ * @struct DeletedPolynomialRecord
+ * @brief Двоичная запись об одном удаленном полиноме
+ */
+struct DeletedPolynomialRecord {
+    std::uint64_t sequence; ///< Порядковый номер удаления
+    double a;               ///< Коэффициент при x²
+    double b;               ///< Коэффициент при x
+    double c;               ///< Свободный член
+};
+
+/**
+ * @struct HistoryRing
+ * @brief Кольцевой буфер истории с ограниченной емкостью и прореживанием
+ * @tparam Record Тип хранимой записи
  * 
- * @note Все статические данные класса автоматически очищаются при завершении программы
+ * @details
+ * Хранит только последние capacity записей, причем сохраняется лишь каждое
+ * sampleEvery-е событие. Счетчик totalEvents учитывает все события точно,
+ * поэтому объем памяти не зависит от времени работы программы.
+ * Буфер берется из переданного ресурса памяти (обычно - арены сессии
+ * статистики), а не из глобального operator new.
  */
-class Polynomial {
-private:
-    double a; ///< Коэффициент при x²
-    double b; ///< Коэффициент при x
-    double c; ///< Свободный член
+template <typename Record>
+struct HistoryRing {
+    std::pmr::memory_resource* resource; ///< Источник памяти для буфера
+    Record* entries;            ///< Буфер записей (выделяется при первой записи)
+    std::size_t capacity;       ///< Максимальное количество хранимых записей
+    std::size_t sampleEvery;    ///< Сохраняется каждое sampleEvery-е событие
+    std::uint64_t totalEvents;  ///< Точное количество всех событий
+    std::uint64_t storedEvents; ///< Количество событий, попавших в буфер
     
     /**
-     * @var static int Polynomial::rootCalculationCount
-     * @brief Счетчик общего количества вычислений корней
-     * @details Увеличивается при каждом вызове метода findRoots()
+     * @brief Конструктор
+     * @param maxEntries Емкость буфера
+     * @param sampleRate Частота прореживания (1 - сохранять все события)
+     * @param memory Ресурс памяти для буфера
      */
-    static int rootCalculationCount;
+    HistoryRing(std::size_t maxEntries, std::size_t sampleRate,
+                std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : resource(memory), entries(nullptr), capacity(maxEntries), sampleEvery(sampleRate),
+          totalEvents(0), storedEvents(0) {}
+    
+    HistoryRing(const HistoryRing&) = delete;
+    HistoryRing& operator=(const HistoryRing&) = delete;
+    
+    ~HistoryRing() {
+        release();
+    }
     
     /**
-     * @var static int Polynomial::instanceCount
-     * @brief Счетчик созданных экземпляров класса
-     * @details Увеличивается в конструкторах, уменьшается в деструкторе
+     * @brief Изменяет политику хранения
+     * @param maxEntries Новая емкость буфера (0 - не хранить записи)
+     * @param sampleRate Новая частота прореживания (0 трактуется как 1)
+     * @post Сохраненные записи удаляются, счетчик событий сохраняется
      */
-    static int instanceCount;
+    void configure(std::size_t maxEntries, std::size_t sampleRate) {
+        freeEntries();
+        capacity = maxEntries;
+        sampleEvery = (sampleRate == 0) ? 1 : sampleRate;
+        storedEvents = 0;
+    }
     
     /**
-     * @var static char** Polynomial::deletedPolynomials
-     * @brief Динамический массив для хранения информации об удаленных полиномах
-     * @details Используется для финальной статистики
+     * @brief Регистрирует событие
+     * @param record Запись о событии
+     * @return true, если запись попала в буфер
      */
-    static char** deletedPolynomials;
+    bool push(const Record& record) {
+        ++totalEvents;
+        if (capacity == 0 || (totalEvents - 1) % sampleEvery != 0) {
+            return false;
+        }
+        if (entries == nullptr) {
+            entries = static_cast<Record*>(resource->allocate(capacity * sizeof(Record),
+                                                              alignof(Record)));
+        }
+        entries[storedEvents % capacity] = record;
+        ++storedEvents;
+        return true;
+    }
     
     /**
-     * @var static int Polynomial::deletedCapacity
-     * @brief Текущая емкость массива deletedPolynomials
+     * @brief Возвращает количество хранимых записей
      */
-    static int deletedCapacity;
+    std::size_t size() const {
+        return storedEvents < capacity ? static_cast<std::size_t>(storedEvents) : capacity;
+    }
     
     /**
-     * @var static int Polynomial::deletedCount
-     * @brief Количество элементов в массиве deletedPolynomials
+     * @brief Возвращает запись по индексу в хронологическом порядке
+     * @param index 0 - самая старая из хранимых записей
      */
-    static int deletedCount;
+    const Record& at(std::size_t index) const {
+        return entries[(storedEvents - size() + index) % capacity];
+    }
     
     /**
-     * @var static char** Polynomial::rootCalculations
-     * @brief Динамический массив для хранения записей о вычислениях корней
+     * @brief Возвращает запись, отсчитывая с конца
+     * @param offset 0 - последняя запись, 1 - предыдущая и т.д.
      */
-    static char** rootCalculations;
+    const Record& fromEnd(std::size_t offset) const {
+        return entries[(storedEvents - 1 - offset) % capacity];
+    }
     
     /**
-     * @var static int Polynomial::rootCalculationsCapacity
-     * @brief Текущая емкость массива rootCalculations
+     * @brief Освобождает буфер и сбрасывает счетчики
+     * @post Политика хранения сохраняется
      */
-    static int rootCalculationsCapacity;
+    void release() {
+        freeEntries();
+        totalEvents = 0;
+        storedEvents = 0;
+    }
     
     /**
-     * @var static int Polynomial::rootCalculationEntries
-     * @brief Количество записей в массиве rootCalculations
+     * @brief Возвращает буфер в ресурс памяти
+     * @details Вызывается до изменения capacity: размер освобождаемого блока
+     * должен совпадать с выделенным
      */
-    static int rootCalculationEntries;
+    void freeEntries() {
+        if (entries != nullptr) {
+            resource->deallocate(entries, capacity * sizeof(Record), alignof(Record));
+            entries = nullptr;
+        }
+    }
+};
+
+/**
+ * @struct RootQuantileSketch
+ * @brief Скетч квантилей значений корней с ограниченной относительной ошибкой
+ * 
+ * @details
+ * Корзины по схеме DDSketch с логарифмически-линейной разбивкой: каждая
+ * двоичная октава модуля делится на 2^subBucketBits равных частей, а номер
+ * корзины - это старшие биты представления double (порядок и первые биты
+ * мантиссы), поэтому добавление значения не вычисляет логарифм. Оценка
+ * квантиля (представитель корзины 2*l*u/(l + u), см. binValue()) отличается
+ * от точного значения не более чем на 1/65 относительно. Отрицательные значения хранятся в отдельных корзинах
+ * по модулю, нули - в отдельном счетчике. Число корзин фиксировано: модули
+ * вне [2^-64, 2^64) попадают в крайние корзины, поэтому память не зависит
+ * от количества значений. Два скетча объединяются сложением корзин.
+ */
+struct RootQuantileSketch {
+    static const int subBucketBits = 5;     ///< log2 числа корзин в октаве
+    static const int octaves = 128;         ///< Октав модуля: [2^-64, 2^64)
+    static const int bins = octaves << subBucketBits; ///< Корзин на каждый знак
+    
+
+    std::uint64_t positive[bins];   ///< Корзины положительных значений
+    std::uint64_t negative[bins];   ///< Корзины отрицательных значений (по модулю)
+    std::uint64_t zeros;            ///< Количество нулей
+    std::uint64_t count;            ///< Общее количество значений
+    
+    RootQuantileSketch() {
+        reset();
+    }
     
     /**
-     * @var static bool Polynomial::programFinished
-     * @brief Флаг завершения программы
-     * @details Используется для определения момента вывода финальной статистики
+     * @brief Очищает скетч
      */
-    static bool programFinished;
+    void reset() {
+        std::memset(positive, 0, sizeof(positive));
+        std::memset(negative, 0, sizeof(negative));
+        zeros = 0;
+        count = 0;
+    }
     
     /**
-     * @brief Добавляет информацию об удалённом полиноме в динамический массив
-     * @param polyInfo Строка с информацией о полиноме
-     * @private
+     * @brief Добавляет конечное значение
+     * @param value Значение корня
      */
-    static void addDeletedPolynomial(const std::string& polyInfo) {
-        if (deletedCount >= deletedCapacity) {
-            int newCapacity = (deletedCapacity == 0) ? 2 : deletedCapacity * 2;
-            char** newArray = new char*[newCapacity];
-            
-            for (int i = 0; i < deletedCount; i++) {
-                newArray[i] = deletedPolynomials[i];
-            }
-            
-            if (deletedPolynomials != nullptr) {
-                delete[] deletedPolynomials;
-            }
-            
-            deletedPolynomials = newArray;
-            deletedCapacity = newCapacity;
+    void add(double value) {
+        if (value > 0) {
+            positive[binIndex(value)]++;
+        } else if (value < 0) {
+            negative[binIndex(-value)]++;
+        } else {
+            zeros++;
         }
-        
-        deletedPolynomials[deletedCount] = new char[polyInfo.length() + 1];
-        strcpy(deletedPolynomials[deletedCount], polyInfo.c_str());
-        deletedCount++;
+        count++;
     }
     
     /**
-     * @brief Добавляет запись о вычислении корней в статический массив
-     * @param calcInfo Строка с информацией о вычислении
-     * @private
+     * @brief Добавляет значения другого скетча
+     * @param other Скетч другого потока
      */
-    static void addRootCalculation(const std::string& calcInfo) {
-        if (rootCalculationEntries >= rootCalculationsCapacity) {
-            int newCapacity = (rootCalculationsCapacity == 0) ? 2 : rootCalculationsCapacity * 2;
-            char** newArray = new char*[newCapacity];
-            
-            for (int i = 0; i < rootCalculationEntries; i++) {
-                newArray[i] = rootCalculations[i];
+    void merge(const RootQuantileSketch& other) {
+        for (int i = 0; i < bins; i++) {
+            positive[i] += other.positive[i];
+            negative[i] += other.negative[i];
+        }
+        zeros += other.zeros;
+        count += other.count;
+    }
+    
+    /**
+     * @brief Оценивает квантиль
+     * @param q Уровень квантиля из [0, 1]
+     * @return Оценка квантиля или NaN для пустого скетча
+     */
+    double quantile(double q) const {
+        if (count == 0) {
+            return NAN;
+        }
+        q = q < 0 ? 0 : (q > 1 ? 1 : q);
+        std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(count - 1));
+        
+        // Порядок по возрастанию: отрицательные от больших модулей к малым, нули, положительные
+        std::uint64_t seen = 0;
+        for (int i = bins - 1; i >= 0; i--) {
+            seen += negative[i];
+            if (seen > rank) {
+                return -binValue(i);
             }
-            
-            if (rootCalculations != nullptr) {
-                delete[] rootCalculations;
+        }
+        seen += zeros;
+        if (seen > rank) {
+            return 0.0;
+        }
+        for (int i = 0; i < bins; i++) {
+            seen += positive[i];
+            if (seen > rank) {
+                return binValue(i);
             }
-            
-            rootCalculations = newArray;
-            rootCalculationsCapacity = newCapacity;
         }
-        
-        rootCalculations[rootCalculationEntries] = new char[calcInfo.length() + 1];
-        strcpy(rootCalculations[rootCalculationEntries], calcInfo.c_str());
-        rootCalculationEntries++;
+        return binValue(bins - 1);
     }
-
-public:
+    
+private:
+    static const int mantissaShift = 52 - subBucketBits; ///< Отбрасываемые биты мантиссы
+    
     /**
-     * @brief Конструктор по умолчанию
-     * @details Создает полином с коэффициентами a=1, b=1, c=1
-     * @post Увеличивает счетчик instanceCount на 1
+     * @var static const std::int64_t RootQuantileSketch::firstBin
+     * @brief Старшие биты представления 2^-64 - начало корзины 0
      */
-    Polynomial() : a(1), b(1), c(1) {
-        instanceCount++;
-    }
+    static const std::int64_t firstBin = std::int64_t(1023 - octaves / 2) << subBucketBits;
     
     /**
-     * @brief Конструктор с одним параметром
-     * @param constant Значение константы c
-     * @details Создает полином с коэффициентами a=0, b=0, c=constant
-     * @post Увеличивает счетчик instanceCount на 1
+     * @brief Возвращает корзину для положительного модуля
+     * @param magnitude Модуль значения (> 0)
      */
-    Polynomial(double constant) : a(0), b(0), c(constant) {
-        instanceCount++;
+    static int binIndex(double magnitude) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &magnitude, sizeof(bits));
+        std::int64_t k = static_cast<std::int64_t>(bits >> mantissaShift) - firstBin;
+        return k < 0 ? 0 : (k > bins - 1 ? bins - 1 : static_cast<int>(k));
     }
     
     /**
-     * @brief Конструктор с тремя параметрами
-     * @param a_val Коэффициент при x²
-     * @param b_val Коэффициент при x
-     * @param c_val Свободный член
-     * @post Увеличивает счетчик instanceCount на 1
+     * @brief Возвращает представителя корзины [l, u)
+     * @details Среднее гармоническое 2*l*u/(l + u) отстоит от обоих краев на
+     * (u - l)/(u + l) = 1/65 относительно; середина (l + u)/2 ошибалась бы
+     * у нижнего края на 1/64
      */
-    Polynomial(double a_val, double b_val, double c_val) 
-        : a(a_val), b(b_val), c(c_val) {
-        instanceCount++;
+    static double binValue(int index) {
+        std::uint64_t lowerBits = static_cast<std::uint64_t>(index + firstBin) << mantissaShift;
+        std::uint64_t upperBits = static_cast<std::uint64_t>(index + 1 + firstBin) << mantissaShift;
+        double lower, upper;
+        std::memcpy(&lower, &lowerBits, sizeof(lower));
+        std::memcpy(&upper, &upperBits, sizeof(upper));
+        return 2 * lower * upper / (lower + upper);
     }
+};
+
+/**
+ * @struct RootAggregate
+ * @brief Потоковые агрегаты по вычислениям корней
+ * 
+ * @details
+ * Обновляется при каждом вычислении с полной статистикой, не храня
+ * отдельных записей, поэтому память постоянна при любом числе вычислений.
+ * Моменты корней ведутся по алгоритму Уэлфорда и объединяются между потоками
+ * формулами Чана; счетчики и скетч квантилей объединяются сложением.
+ */
+struct RootAggregate {
+    /**
+     * @enum RootCase
+     * @brief Классы результата вычисления корней
+     */
+    enum RootCase {
+        twoRoots,       ///< Два различных действительных корня
+        oneRoot,        ///< Кратный корень (D = 0)
+        noRealRoots,    ///< D < 0
+        linear,         ///< a = 0, один корень линейного уравнения
+        constant,       ///< a = 0 и b = 0, корней нет
+        rootCaseCount
+    };
     
     /**
-     * @brief Копирующий конструктор
-     * @param other Полином для копирования
-     * @post Создает глубокую копию полинома
-     * @post Увеличивает счетчик instanceCount на 1
+     * @enum DiscriminantSign
+     * @brief Корзины гистограммы знака дискриминанта b² - 4ac
      */
-    Polynomial(const Polynomial& other) 
-        : a(other.a), b(other.b), c(other.c) {
-        instanceCount++;
+    enum DiscriminantSign {
+        negativeDiscriminant,
+        zeroDiscriminant,
+        positiveDiscriminant,
+        undefinedDiscriminant,  ///< NaN при нечисловых коэффициентах
+        discriminantSignCount
+    };
+    
+    std::uint64_t calculations;                         ///< Учтенные вычисления
+    std::uint64_t caseCounts[rootCaseCount];            ///< Счетчики классов результата
+    std::uint64_t discriminantCounts[discriminantSignCount]; ///< Гистограмма знака D
+    std::uint64_t rootCount;    ///< Учтенные конечные корни
+    double rootMin;             ///< Наименьший корень
+    double rootMax;             ///< Наибольший корень
+    double rootMean;            ///< Среднее корней
+    double rootM2;              ///< Сумма квадратов отклонений от среднего
+    RootQuantileSketch sketch;  ///< Распределение корней
+    
+    RootAggregate() {
+        reset();
     }
     
     /**
-     * @brief Оператор присваивания
-     * @param other Полином для копирования
-     * @return Ссылка на текущий объект
-     * @exception Не генерирует исключений
+     * @brief Очищает агрегаты
      */
-    Polynomial& operator=(const Polynomial& other) {
-        if (this != &other) {
-            a = other.a;
-            b = other.b;
-            c = other.c;
-        }
-        return *this;
+    void reset() {
+        calculations = 0;
+        std::memset(caseCounts, 0, sizeof(caseCounts));
+        std::memset(discriminantCounts, 0, sizeof(discriminantCounts));
+        rootCount = 0;
+        rootMin = INFINITY;
+        rootMax = -INFINITY;
+        rootMean = 0.0;
+        rootM2 = 0.0;
+        sketch.reset();
     }
-
+    
     /**
-     * @brief Деструктор
-     * @details Добавляет информацию об удаленном полиноме в статический массив
-     * @post Уменьшает количество живых экземпляров
-     * @post При завершении программы выводит финальную статистику
+     * @brief Учитывает одно вычисление корней
+     * @param a Коэффициент при x²
+     * @param b Коэффициент при x
+     * @param c Свободный член
+     * @param root1 Первый корень (если существует)
+     * @param root2 Второй корень (если существует)
+     * @param numRoots Количество действительных корней
      */
-    ~Polynomial() {
-        std::string polyInfo = "Polynomial #" + std::to_string(deletedCount + 1) + 
-                              ": " + std::to_string(a) + "x^2 + " + 
-                              std::to_string(b) + "x + " + std::to_string(c);
+    void add(double a, double b, double c, double root1, double root2, int numRoots) {
+        calculations++;
+        if (a == 0) {
+            caseCounts[numRoots == 1 ? linear : constant]++;
+        } else {
+            caseCounts[numRoots == 2 ? twoRoots : (numRoots == 1 ? oneRoot : noRealRoots)]++;
+        }
         
-        addDeletedPolynomial(polyInfo);
+        double discriminant = b * b - 4 * a * c;
+        discriminantCounts[discriminant < 0 ? negativeDiscriminant
+                         : discriminant > 0 ? positiveDiscriminant
+                         : discriminant == 0 ? zeroDiscriminant
+                         : undefinedDiscriminant]++;
         
-        if (programFinished && deletedCount == instanceCount) {
-            printFinalStatistics();
+        if (numRoots > 0) {
+            addRoot(root1);
+        }
+        if (numRoots > 1) {
+            addRoot(root2);
         }
     }
     
     /**
-     * @defgroup StaticMethods Статические методы
-     * @brief Методы для работы со статическими данными класса
-     * @{
+     * @brief Добавляет агрегаты другого потока
+     * @param other Агрегаты для объединения
      */
+    void merge(const RootAggregate& other) {
+        calculations += other.calculations;
+        for (int i = 0; i < rootCaseCount; i++) {
+            caseCounts[i] += other.caseCounts[i];
+        }
+        for (int i = 0; i < discriminantSignCount; i++) {
+            discriminantCounts[i] += other.discriminantCounts[i];
+        }
+        if (other.rootCount > 0) {
+            double total = static_cast<double>(rootCount + other.rootCount);
+            double delta = other.rootMean - rootMean;
+            double weight = static_cast<double>(other.rootCount) / total;
+            rootMean += delta * weight;
+            rootM2 += other.rootM2 + delta * delta * static_cast<double>(rootCount) * weight;
+            rootCount += other.rootCount;
+            rootMin = std::min(rootMin, other.rootMin);
+            rootMax = std::max(rootMax, other.rootMax);
+        }
+        sketch.merge(other.sketch);
+    }
     
     /**
-     * @brief Устанавливает флаг завершения программы
-     * @param finished true - программа завершена, false - программа работает
+     * @brief Возвращает выборочную дисперсию корней
+     * @return Дисперсия (0, если корней меньше двух)
      */
-    static void setProgramFinished(bool finished) {
-        programFinished = finished;
+    double rootVariance() const {
+        return rootCount > 1 ? rootM2 / static_cast<double>(rootCount - 1) : 0.0;
     }
     
     /**
-     * @brief Выводит статистику вычисления корней
-     * @details Показывает:
-     * - Общее количество вычислений корней
-     * - Последнее вычисление
-     * - Предыдущее вычисление
-     * - Все вычисления в хронологическом порядке
+     * @brief Оценивает квантиль корней
+     * @param q Уровень квантиля из [0, 1]
+     * @return Оценка скетча, ограниченная точными min и max (NaN, если корней нет)
      */
-    static void showRootCalculationStats() {
-        std::cout << "\n" << std::string(40, '=') << std::endl;
-        std::cout << "  STATISTIKA VYCHISLENIYA KORNEY" << std::endl;
-        std::cout << std::string(40, '=') << std::endl;
-        
-        std::cout << "Vsego vychisleniy korney s nachala programmy: " 
-                  << rootCalculationCount << std::endl;
-        
-        if (rootCalculationEntries > 0) {
-            std::cout << "\nPoslednee vychislenie:" << std::endl;
-            std::cout << rootCalculations[rootCalculationEntries - 1] << std::endl;
-            
-            if (rootCalculationEntries > 1) {
-                std::cout << "\nPredydushchee vychislenie:" << std::endl;
-                std::cout << rootCalculations[rootCalculationEntries - 2] << std::endl;
-            }
-            
-            std::cout << "\nVse vychisleniya (" << rootCalculationEntries << "):" << std::endl;
-            for (int i = 0; i < rootCalculationEntries; i++) {
-                std::cout << i+1 << ". " << rootCalculations[i] << std::endl;
-            }
-        } else {
-            std::cout << "\nFunkciya poiska korney eshche ne ispolzovalas." << std::endl;
+    double rootQuantile(double q) const {
+        if (rootCount == 0) {
+            return NAN;
         }
-        
-        std::cout << std::string(40, '=') << std::endl;
+        return std::min(std::max(sketch.quantile(q), rootMin), rootMax);
     }
     
+private:
     /**
-     * @brief Выводит финальную статистику программы
-     * @details Вызывается автоматически при завершении программы
-     * Показывает:
-     * - Все удаленные полиномы
-     * - Все вычисления корней
-     * - Итоговую статистику
+     * @brief Учитывает корень в моментах и скетче
+     * @param root Значение корня; бесконечные и NaN пропускаются
      */
-    static void printFinalStatistics() {
-        std::cout << "\n" << std::string(50, '=') << std::endl;
-        std::cout << "          FINAL STATISTICS" << std::endl;
-        std::cout << std::string(50, '=') << std::endl;
-        
-        std::cout << "\n=== ALL DELETED POLYNOMIALS ===" << std::endl;
-        if (deletedCount == 0) {
-            std::cout << "No polynomials were deleted." << std::endl;
-        } else {
-            for (int i = 0; i < deletedCount; i++) {
-                std::cout << i+1 << ". " << deletedPolynomials[i] << std::endl;
-            }
-            std::cout << "\nTotal deleted polynomials: " << deletedCount << std::endl;
-        }
-        
-        std::cout << "\n=== ROOT CALCULATIONS SUMMARY ===" << std::endl;
-        if (rootCalculationEntries == 0) {
-            std::cout << "Ni odnogo kornya ne bili vichisleni." << std::endl;
-        } else {
-            for (int i = 0; i < rootCalculationEntries; i++) {
-                std::cout << i+1 << ". " << rootCalculations[i] << std::endl;
-            }
-            std::cout << "\nTotal root calculations: " << rootCalculationEntries << std::endl;
+    void addRoot(double root) {
+        if (!std::isfinite(root)) {
+            return;
         }
-        
-        std::cout << std::string(50, '=') << std::endl;
+        rootCount++;
+        double delta = root - rootMean;
+        rootMean += delta / static_cast<double>(rootCount);
+        rootM2 += delta * (root - rootMean);
+        rootMin = std::min(rootMin, root);
+        rootMax = std::max(rootMax, root);
+        sketch.add(root);
+    }
+};
+
+/**
+ * @enum LatencyOperation
+ * @brief Операции, для которых ведутся гистограммы задержек
+ */
+enum LatencyOperation {
+    findRootsLatency,   ///< BasicPolynomial::findRoots()
+    evaluateLatency,    ///< BasicPolynomial::evaluate() (и сравнения через него)
+    arithmeticLatency,  ///< ++, --, +=, -=, *=, /= (бинарные операторы через них)
+    arrayAddLatency,    ///< PolynomialArray::add() с учетом роста колонок
+    destroyLatency,     ///< Деструктор полинома со статистикой
+    latencyOperationCount
+};
+
+/**
+ * @brief Возвращает название операции для вывода
+ * @param operation Операция
+ */
+inline const char* latencyOperationName(LatencyOperation operation) {
+    static const char* const names[latencyOperationCount] = {
+        "findRoots", "evaluate", "arithmetic", "PolynomialArray::add", "destructor"
+    };
+    return names[operation];
+}
+
+/**
+ * @brief Возвращает отметку времени для замера задержек
+ * @return Такты TSC на x86, иначе наносекунды steady_clock
+ * @details Чтение TSC заметно дешевле steady_clock::now(); такты переводятся
+ * в наносекунды только при выводе (см. PolynomialStatistics::ticksPerNanosecond()).
+ * Предполагается инвариантный TSC (constant_tsc), как на всех современных x86.
+ */
+inline std::uint64_t latencyTimestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @struct LatencyHistogram
+ * @brief Гистограмма задержек с лог-линейными корзинами
+ * 
+ * @details
+ * Значения - разности latencyTimestamp(). Разбивка как в HdrHistogram:
+ * значения меньше 2^subBucketBits хранятся точно, каждая следующая двоичная
+ * октава делится на 2^subBucketBits равных корзин, поэтому относительная
+ * ошибка не превышает 1/16 и не меняется при переводе тактов в наносекунды.
+ * Номер корзины вычисляется по старшему биту без деления и логарифма.
+ * Значения от 2^44 (около 1.5 часа тактами при 3 ГГц) попадают в последнюю корзину.
+ * 
+ * Корзины изменяет только поток-владелец шарда (как и остальные счетчики),
+ * а объединение читает их атомарно, без блокировок.
+ */
+struct LatencyHistogram {
+    static const int subBucketBits = 4;     ///< log2 числа корзин в октаве
+    static const int maxMagnitude = 44;     ///< Значения ограничены 2^44 - 1
+    static const int buckets = (maxMagnitude - subBucketBits + 1) << subBucketBits; ///< Число корзин
+    
+    std::atomic<std::uint64_t> counts[buckets]; ///< Количество значений в корзинах
+    
+    LatencyHistogram() {
+        reset();
     }
     
     /**
-     * @brief Очищает все статические данные класса
-     * @details Освобождает динамическую память, сбрасывает счетчики
-     * @warning Должен вызываться только при завершении программы
+     * @brief Обнуляет корзины
      */
-    static void cleanupStaticData() {
-        for (int i = 0; i < deletedCount; i++) {
-            delete[] deletedPolynomials[i];
-        }
-        delete[] deletedPolynomials;
-        deletedPolynomials = nullptr;
-        deletedCapacity = 0;
-        deletedCount = 0;
-        
-        for (int i = 0; i < rootCalculationEntries; i++) {
-            delete[] rootCalculations[i];
+    void reset() {
+        for (std::atomic<std::uint64_t>& count : counts) {
+            count.store(0, std::memory_order_relaxed);
         }
-        delete[] rootCalculations;
-        rootCalculations = nullptr;
-        rootCalculationsCapacity = 0;
-        rootCalculationEntries = 0;
-        
-        rootCalculationCount = 0;
-        instanceCount = 0;
-        programFinished = false;
     }
-
+    
     /**
-     * @brief Возвращает количество вычислений корней
-     * @return Количество вызовов findRoots()
+     * @brief Учитывает значение (вызывается только потоком-владельцем)
+     * @param elapsed Задержка операции в единицах latencyTimestamp()
      */
-    static int getRootCalculationCount() {
-        return rootCalculationCount;
+    void record(std::uint64_t elapsed) {
+        std::atomic<std::uint64_t>& count = counts[bucketIndex(elapsed)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
     }
-
+    
     /**
-     * @brief Возвращает количество созданных экземпляров
-     * @return Общее количество созданных объектов Polynomial
+     * @brief Возвращает корзину значения
+     * @param value Значение в единицах latencyTimestamp()
      */
-    static int getInstanceCount() {
-        return instanceCount;
+    static int bucketIndex(std::uint64_t value) {
+        if (value < (std::uint64_t(1) << subBucketBits)) {
+            return static_cast<int>(value);
+        }
+        if (value >= (std::uint64_t(1) << maxMagnitude)) {
+            return buckets - 1;
+        }
+        int magnitude = 63 - __builtin_clzll(value);
+        int shift = magnitude - subBucketBits;
+        int group = shift + 1;
+        int sub = static_cast<int>(value >> shift) & ((1 << subBucketBits) - 1);
+        return (group << subBucketBits) + sub;
+    }
+    
+    /**
+     * @brief Возвращает наибольшее значение, попадающее в корзину
+     * @param index Номер корзины
+     * @details Как и HdrHistogram, перцентили сообщаются верхней границей корзины
+     */
+    static std::uint64_t bucketUpperBound(int index) {
+        int group = index >> subBucketBits;
+        std::uint64_t sub = static_cast<std::uint64_t>(index & ((1 << subBucketBits) - 1));
+        if (group == 0) {
+            return sub;
+        }
+        int shift = group - 1;
+        return ((((std::uint64_t(1) << subBucketBits) + sub + 1) << shift)) - 1;
     }
+};
 
+/**
+ * @struct LatencyDistribution
+ * @brief Объединенная по потокам гистограмма задержек одной операции
+ */
+struct LatencyDistribution {
+    std::uint64_t counts[LatencyHistogram::buckets]; ///< Количество значений в корзинах
+    std::uint64_t total;                             ///< Общее количество значений
+    
+    LatencyDistribution() : total(0) {
+        std::memset(counts, 0, sizeof(counts));
+    }
+    
     /**
-     * @brief Сбрасывает всю статистику
-     * @details Очищает все статические данные и сбрасывает счетчики
+     * @brief Добавляет корзины гистограммы шарда
+     * @param histogram Гистограмма потока
      */
-    static void resetStatistics() {
-        cleanupStaticData();
+    void merge(const LatencyHistogram& histogram) {
+        for (int i = 0; i < LatencyHistogram::buckets; i++) {
+            std::uint64_t count = histogram.counts[i].load(std::memory_order_relaxed);
+            counts[i] += count;
+            total += count;
+        }
     }
     
-    /** @} */ // конец группы StaticMethods
-
     /**
-     * @brief Находит корни квадратного уравнения
-     * @param[out] root1 Первый корень (если существует)
-     * @param[out] root2 Второй корень (если существует)
-     * @param[out] numRoots Количество действительных корней (0, 1 или 2)
-     * @details Вычисляет корни уравнения ax² + bx + c = 0
-     * Обрабатывает случаи:
-     * - a = 0 (линейное уравнение)
-     * - Дискриминант > 0 (два корня)
-     * - Дискриминант = 0 (один корень)
-     * - Дискриминант < 0 (нет действительных корней)
-     * @post Увеличивает rootCalculationCount на 1
-     * @post Добавляет запись в rootCalculations
+     * @brief Возвращает перцентиль задержки
+     * @param q Уровень из [0, 1]
+     * @return Верхняя граница корзины, содержащей значение ранга ceil(q * total)
+     * (0 для пустой гистограммы)
      */
-    void findRoots(double& root1, double& root2, int& numRoots) {
-        ++rootCalculationCount;
-        numRoots = 0;
-        
-        std::string calcInfo = "Calculation #" + std::to_string(rootCalculationCount) + 
-                              " for " + std::to_string(a) + "x^2 + " + 
-                              std::to_string(b) + "x + " + std::to_string(c);
-        
-        if (a == 0) {
-            if (b != 0) {
-                root1 = -c / b;
-                numRoots = 1;
-                calcInfo += " -> Lineinoe uravnenie, koren: " + std::to_string(root1);
-            } else {
-                calcInfo += " -> Constant, net kornei";
-            }
-        } else {
-            double discriminant = b * b - 4 * a * c;
-            
-            if (discriminant > 0) {
-                root1 = (-b + sqrt(discriminant)) / (2 * a);
-                root2 = (-b - sqrt(discriminant)) / (2 * a);
-                numRoots = 2;
-                calcInfo += " -> Dva kornya: " + std::to_string(root1) + 
-                           ", " + std::to_string(root2);
-            } else if (discriminant == 0) {
-                root1 = -b / (2 * a);
-                numRoots = 1;
-                calcInfo += " -> Odin koren: " + std::to_string(root1);
-            } else {
-                calcInfo += " -> Net deistvitelnih korney (discriminant < 0)";
+    std::uint64_t percentile(double q) const {
+        if (total == 0) {
+            return 0;
+        }
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total)));
+        rank = rank == 0 ? 1 : (rank > total ? total : rank);
+        std::uint64_t seen = 0;
+        for (int i = 0; i < LatencyHistogram::buckets; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return LatencyHistogram::bucketUpperBound(i);
             }
         }
-        
-        addRootCalculation(calcInfo);
+        return LatencyHistogram::bucketUpperBound(LatencyHistogram::buckets - 1);
     }
+};
 
-    /**
-     * @defgroup UnaryOperators Унарные операторы
-     * @brief Операции инкремента и декремента
-     * @{
-     */
+/**
+ * @enum PerfCounter
+ * @brief Аппаратные счетчики, читаемые через perf_event_open
+ */
+enum PerfCounter {
+    cyclesCounter,          ///< Такты процессора
+    instructionsCounter,    ///< Выполненные инструкции
+    branchMissesCounter,    ///< Неверно предсказанные переходы
+    cacheMissesCounter,     ///< Промахи последнего уровня кэша
+    perfCounterCount
+};
+
+/**
+ * @enum PerfOperation
+ * @brief Пакетные операции, вокруг которых читаются счетчики
+ */
+enum PerfOperation {
+    findRootsPerf,  ///< Пакетное вычисление корней
+    evaluatePerf,   ///< Пакетное вычисление значений
+    perfOperationCount
+};
+
+/**
+ * @brief Возвращает название счетчика для вывода
+ * @param counter Счетчик
+ */
+inline const char* perfCounterName(PerfCounter counter) {
+    static const char* const names[perfCounterCount] = {
+        "cycles", "instructions", "branch-misses", "cache-misses"
+    };
+    return names[counter];
+}
+
+/**
+ * @brief Возвращает название пакетной операции для вывода
+ * @param operation Операция
+ */
+inline const char* perfOperationName(PerfOperation operation) {
+    static const char* const names[perfOperationCount] = {"findRoots", "evaluate"};
+    return names[operation];
+}
+
+/**
+ * @struct PerfSample
+ * @brief Показания группы счетчиков в один момент
+ */
+struct PerfSample {
+    std::uint64_t values[perfCounterCount]; ///< Значения счетчиков (0 для недоступных)
+    std::uint64_t timeEnabled;              ///< Время, когда группа была включена, нс
+    std::uint64_t timeRunning;              ///< Время, когда группа реально считала, нс
+};
+
+/**
+ * @class PerfCounterGroup
+ * @brief Группа счетчиков perf_event текущего потока
+ * 
+ * @details
+ * Счетчики открываются одной группой (лидер - cycles) только для
+ * пользовательского кода вызывающего потока, считают непрерывно и читаются
+ * одним read(). Разность двух показаний масштабируется на долю времени,
+ * когда группа действительно была на PMU (мультиплексирование ядром).
+ * Если лидер не открылся (нет PMU, запрет perf_event_paranoid, seccomp),
+ * группа остается недоступной; недоступные члены группы пропускаются.
+ */
+class PerfCounterGroup {
+public:
+    PerfCounterGroup() : leader(-1), members(0), error(0) {
+        for (int& slot : slots) {
+            slot = -1;
+        }
+        for (int& fd : fds) {
+            fd = -1;
+        }
+        open();
+    }
     
-    /**
-     * @brief Префиксный инкремент
-     * @return Ссылка на измененный полином
-     * @post Увеличивает все коэффициенты на 1
-     */
-    Polynomial& operator++() {
-        ++a; ++b; ++c;
-        return *this;
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+    
+    ~PerfCounterGroup() {
+#if defined(POLY_PERF_EVENTS)
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
     }
-
+    
     /**
-     * @brief Постфиксный инкремент
-     * @return Копия полинома до изменения
-     * @post Увеличивает все коэффициенты на 1
+     * @brief Проверяет, открыта ли группа
      */
-    Polynomial operator++(int) {
-        Polynomial temp = *this;
-        ++(*this);
-        return temp;
+    bool available() const {
+        return leader >= 0;
     }
-
+    
     /**
-     * @brief Префиксный декремент
-     * @return Ссылка на измененный полином
-     * @post Уменьшает все коэффициенты на 1
+     * @brief Возвращает маску открытых счетчиков (бит i - PerfCounter i)
      */
-    Polynomial& operator--() {
-        --a; --b; --c;
-        return *this;
+    unsigned availableMask() const {
+        unsigned mask = 0;
+        for (int i = 0; i < perfCounterCount; i++) {
+            mask |= (slots[i] >= 0) ? (1u << i) : 0u;
+        }
+        return mask;
     }
-
+    
     /**
-     * @brief Постфиксный декремент
-     * @return Копия полинома до изменения
-     * @post Уменьшает все коэффициенты на 1
+     * @brief Возвращает errno неудачного открытия лидера (0 - успех)
      */
-    Polynomial operator--(int) {
-        Polynomial temp = *this;
-        --(*this);
-        return temp;
+    int openError() const {
+        return error;
     }
     
-    /** @} */ // конец группы UnaryOperators
-
     /**
-     * @defgroup CompoundAssignment Составные операторы присваивания
-     * @brief Операторы вида @c operator@=
-     * @{
+     * @brief Читает показания всех счетчиков группы
+     * @param[out] sample Показания
+     * @return true, если чтение удалось
      */
+    bool read(PerfSample& sample) const {
+#if defined(POLY_PERF_EVENTS)
+        // Формат PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr]
+        std::uint64_t buffer[3 + perfCounterCount];
+        ssize_t expected = static_cast<ssize_t>((3 + members) * sizeof(std::uint64_t));
+        if (leader < 0 || ::read(leader, buffer, sizeof(buffer)) != expected) {
+            return false;
+        }
+        sample.timeEnabled = buffer[1];
+        sample.timeRunning = buffer[2];
+        for (int i = 0; i < perfCounterCount; i++) {
+            sample.values[i] = (slots[i] >= 0) ? buffer[3 + slots[i]] : 0;
+        }
+        return true;
+#else
+        (void)sample;
+        return false;
+#endif
+    }
+    
+private:
+    int leader;                     ///< Дескриптор лидера группы (-1 - недоступна)
+    int members;                    ///< Количество открытых счетчиков
+    int error;                      ///< errno при открытии лидера
+    int slots[perfCounterCount];    ///< Позиция счетчика в ответе read() или -1
+    int fds[perfCounterCount];      ///< Дескрипторы счетчиков
     
     /**
-     * @brief Оператор сложения с присваиванием
-     * @param other Полином для сложения
-     * @return Ссылка на текущий объект
+     * @brief Открывает счетчики группы
      */
-    Polynomial& operator+=(const Polynomial& other) {
-        a += other.a;
-        b += other.b;
-        c += other.c;
-        return *this;
+    void open() {
+#if defined(POLY_PERF_EVENTS)
+        static const std::uint64_t configs[perfCounterCount] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+        };
+        for (int i = 0; i < perfCounterCount; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader,
+                                              PERF_FLAG_FD_CLOEXEC));
+            if (fd < 0) {
+                if (i == 0) {
+                    error = errno;
+                    return;
+                }
+                continue;
+            }
+            if (i == 0) {
+                leader = fd;
+            }
+            fds[i] = fd;
+            slots[i] = members++;
+        }
+#else
+        error = ENOSYS;
+#endif
     }
+};
 
+/**
+ * @struct PerfCounterTotals
+ * @brief Накопленные показания счетчиков одной операции в шарде
+ * @details Как и остальные счетчики шарда, изменяется только потоком-владельцем
+ */
+struct PerfCounterTotals {
+    std::atomic<std::uint64_t> batches;                     ///< Измеренные пакеты
+    std::atomic<std::uint64_t> items;                       ///< Элементы в этих пакетах
+    std::atomic<std::uint64_t> counters[perfCounterCount];  ///< Сумма приращений счетчиков
+    
+    PerfCounterTotals() {
+        reset();
+    }
+    
     /**
-     * @brief Оператор вычитания с присваиванием
-     * @param other Полином для вычитания
-     * @return Ссылка на текущий объект
+     * @brief Обнуляет показания
      */
-    Polynomial& operator-=(const Polynomial& other) {
-        a -= other.a;
-        b -= other.b;
-        c -= other.c;
-        return *this;
+    void reset() {
+        batches.store(0, std::memory_order_relaxed);
+        items.store(0, std::memory_order_relaxed);
+        for (std::atomic<std::uint64_t>& counter : counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
     }
+};
+
+/**
+ * @defgroup Statistics Статистика
+ * @brief Общая статистика использования квадратных полиномов
+ * @{
+ */
 
+/**
+ * @struct StatisticsShard
+ * @brief Статистика, собираемая одним потоком
+ * 
+ * @details
+ * Счетчики изменяет только поток-владелец, поэтому достаточно атомарных
+ * чтения и записи с порядком relaxed, без блокирующих read-modify-write.
+ * Истории и агрегаты защищены собственным мьютексом шарда: его захватывает владелец
+ * и, изредка, вывод статистики, так что конкуренции за него практически нет.
+ * Шард выровнен по кэш-линии, чтобы разные потоки не делили одни и те же линии.
+ */
+struct alignas(64) StatisticsShard {
+    std::atomic<std::uint64_t> instances;        ///< Созданные экземпляры
+    std::atomic<std::uint64_t> deletions;        ///< Удаленные экземпляры
+    std::atomic<std::uint64_t> rootCalculations; ///< Вычисления корней
+    std::atomic<std::uint64_t> rootCacheHits;    ///< Попадания в кэши корней
+    std::atomic<std::uint64_t> rootCacheMisses;  ///< Промахи кэшей корней
+    
+    std::mutex historyMutex;                                ///< Защищает истории и агрегаты
+    HistoryRing<DeletedPolynomialRecord> deletedHistory;    ///< История удалений потока
+    HistoryRing<RootCalculationRecord> rootHistory;         ///< История вычислений потока
+    RootAggregate rootAggregate;                            ///< Агрегаты всех вычислений потока
+    LatencyHistogram latency[latencyOperationCount];        ///< Задержки операций потока
+    PerfCounterTotals perf[perfOperationCount];             ///< Аппаратные счетчики пакетов потока
+    
+    bool inUse;                 ///< Закреплен ли шард за живым потоком
+    StatisticsShard* next;      ///< Следующий шард в реестре
+    
     /**
-     * @brief Оператор умножения на скаляр с присваиванием
-     * @param scalar Скаляр для умножения
-     * @return Ссылка на текущий объект
+     * @brief Конструктор
+     * @param rootEntries Емкость истории вычислений
+     * @param rootSample Прореживание истории вычислений
+     * @param deletedEntries Емкость истории удалений
+     * @param deletedSample Прореживание истории удалений
+     * @param memory Ресурс памяти для буферов историй
      */
-    Polynomial& operator*=(double scalar) {
-        a *= scalar;
-        b *= scalar;
-        c *= scalar;
-        return *this;
-    }
+    StatisticsShard(std::size_t rootEntries, std::size_t rootSample,
+                    std::size_t deletedEntries, std::size_t deletedSample,
+                    std::pmr::memory_resource* memory)
+        : instances(0), deletions(0), rootCalculations(0), rootCacheHits(0), rootCacheMisses(0),
+          deletedHistory(deletedEntries, deletedSample, memory),
+          rootHistory(rootEntries, rootSample, memory),
+          inUse(false), next(nullptr) {}
+};
 
+/**
+ * @class PolynomialStatistics
+ * @brief Потокобезопасные счетчики и история, общие для всех вариантов полиномов
+ * 
+ * @details
+ * Данные поступают через политики статистики BasicPolynomial (CountingStatistics,
+ * FullStatistics), поэтому полиномы без статистики их не затрагивают.
+ * 
+ * Каждый поток пишет в собственный StatisticsShard, поэтому findRoots() и
+ * деструкторы из разных потоков не конкурируют ни за общую блокировку, ни за
+ * общие кэш-линии. Шарды объединяются лениво — при чтении счетчиков и выводе
+ * статистики. Порядковые номера записей берутся из общего счетчика (один
+ * fetch_add на запись или на пакет), поэтому нумерация сплошная при любом
+ * числе потоков, а объединенная история упорядочена по времени регистрации.
+ * 
+ * Счетчики шардов владельцы изменяют без read-modify-write, поэтому сброс
+ * статистики (cleanupStaticData(), resetStatistics()) допустим, только когда
+ * другие потоки не регистрируют события.
+ * 
+ * Буферы историй берутся из арены сессии (sessionResource()); ее же могут
+ * использовать долгоживущие хранилища полиномов. cleanupStaticData()
+ * возвращает всю память арены разом.
+ * 
+ * @note Все статические данные класса автоматически очищаются при завершении программы
+ */
+class PolynomialStatistics {
+private:
     /**
-     * @brief Оператор деления на скаляр с присваиванием
-     * @param scalar Скаляр для деления
-     * @return Ссылка на текущий объект
-     * @throws std::invalid_argument если scalar = 0
+     * @struct Totals
+     * @brief Объединенные по всем шардам счетчики
      */
-    Polynomial& operator/=(double scalar) {
-        if (scalar == 0) {
-            throw std::invalid_argument("Delenie na nol!");
-        }
-        a /= scalar;
-        b /= scalar;
-        c /= scalar;
-        return *this;
-    }
+    struct Totals {
+        std::uint64_t instances;        ///< Созданные экземпляры
+        std::uint64_t deletions;        ///< Удаленные экземпляры
+        std::uint64_t rootCalculations; ///< Вычисления корней
+        std::uint64_t rootCacheHits;    ///< Попадания в кэши корней
+        std::uint64_t rootCacheMisses;  ///< Промахи кэшей корней
+    };
     
-    /** @} */ // конец группы CompoundAssignment
-
     /**
-     * @defgroup ArithmeticOperations Арифметические операции
-     * @brief Бинарные арифметические операторы
-     * @{
+     * @struct ShardLease
+     * @brief Закрепление шарда за потоком
+     * @details При завершении потока шард возвращается в реестр; его данные
+     * сохраняются и продолжают учитываться в статистике. После этого
+     * leaseReleased не дает снова обратиться к уже уничтоженной аренде
      */
+    struct ShardLease {
+        StatisticsShard* shard = nullptr; ///< Закрепленный шард
+        
+        ~ShardLease() {
+            leaseReleased = true;
+            if (shard != nullptr) {
+                std::lock_guard<std::mutex> lock(registryMutex);
+                shard->inUse = false;
+                currentShard = nullptr;
+            }
+        }
+    };
     
     /**
-     * @brief Сложение двух полиномов
-     * @param lhs Левый операнд
-     * @param rhs Правый операнд
-     * @return Новый полином - сумма lhs и rhs
+     * @class LocalShard
+     * @brief Шард текущего потока на время регистрации одного события
+     * 
+     * @details
+     * Обычно это закрепленный за потоком шард, и объект ничего не блокирует.
+     * Деструкторы thread_local при завершении потока выполняются в порядке,
+     * обратном созданию, поэтому полином из другого thread_local может быть
+     * удален уже после ShardLease. Такие события пишутся в общий exitShard,
+     * и на время записи объект удерживает exitShardMutex.
      */
-    friend Polynomial operator+(Polynomial lhs, const Polynomial& rhs) {
-        lhs += rhs;
-        return lhs;
-    }
-
+    class LocalShard {
+    public:
+        LocalShard() : shard(currentShard) {
+            if (shard == nullptr) {
+                shard = &acquireShard(exitLock);
+            }
+        }
+        
+        StatisticsShard& operator*() const {
+            return *shard;
+        }
+        
+        StatisticsShard* operator->() const {
+            return shard;
+        }
+    
+    private:
+        StatisticsShard* shard;                 ///< Шард для записи события
+        std::unique_lock<std::mutex> exitLock;  ///< Захвачен, если shard - exitShard
+    };
+    
     /**
-     * @brief Вычитание двух полиномов
-     * @param lhs Левый операнд
-     * @param rhs Правый операнд
-     * @return Новый полином - разность lhs и rhs
+     * @var static StatisticsShard* PolynomialStatistics::shards
+     * @brief Реестр (односвязный список) всех шардов
      */
-    friend Polynomial operator-(Polynomial lhs, const Polynomial& rhs) {
-        lhs -= rhs;
-        return lhs;
-    }
-
+    static StatisticsShard* shards;
+    
     /**
-     * @brief Умножение полинома на скаляр
-     * @param lhs Полином
-     * @param scalar Скаляр
-     * @return Новый полином - произведение lhs и scalar
+     * @var static std::mutex PolynomialStatistics::registryMutex
+     * @brief Защищает реестр шардов и настройки хранения истории
+     * @details Захватывается только при появлении нового потока и при чтении статистики
      */
-    friend Polynomial operator*(Polynomial lhs, double scalar) {
-        lhs *= scalar;
-        return lhs;
-    }
-
+    static std::mutex registryMutex;
+    
     /**
-     * @brief Умножение скаляра на полином
-     * @param scalar Скаляр
-     * @param rhs Полином
-     * @return Новый полином - произведение scalar и rhs
+     * @var static thread_local StatisticsShard* PolynomialStatistics::currentShard
+     * @brief Шард текущего потока
      */
-    friend Polynomial operator*(double scalar, const Polynomial& rhs) {
-        Polynomial result = rhs;
-        result *= scalar;
-        return result;
-    }
-
+    static thread_local StatisticsShard* currentShard;
+    
     /**
-     * @brief Деление полинома на скаляр
-     * @param lhs Полином
-     * @param scalar Скаляр
-     * @return Новый полином - частное lhs и scalar
-     * @throws std::invalid_argument если scalar = 0
+     * @var static thread_local bool PolynomialStatistics::leaseReleased
+     * @brief Аренда шарда текущего потока уже уничтожена (поток завершается)
+     * @details Тривиально разрушаемая переменная остается доступной и в
+     * деструкторах других thread_local этого потока
      */
-    friend Polynomial operator/(Polynomial lhs, double scalar) {
-        lhs /= scalar;
-        return lhs;
-    }
+    static thread_local bool leaseReleased;
     
-    /** @} */ // конец группы ArithmeticOperations
-
     /**
-     * @defgroup ComparisonOperations Операции сравнения
-     * @brief Операторы сравнения полиномов
-     * @details Все операторы сравнения работают на основе значения полинома в точке x=2
-     * @{
+     * @var static StatisticsShard* PolynomialStatistics::exitShard
+     * @brief Общий шард для событий потоков, уже вернувших свой шард
+     * @details Никогда не закрепляется за потоком; запись - под exitShardMutex
      */
+    static StatisticsShard* exitShard;
     
     /**
-     * @brief Оператор "меньше"
-     * @details Сравнивает значения полиномов в точке x=2
+     * @var static std::mutex PolynomialStatistics::exitShardMutex
+     * @brief Делает запись в exitShard однопоточной, как в закрепленный шард
      */
-    friend bool operator<(const Polynomial& lhs, const Polynomial& rhs) {
-        return lhs.evaluate(2) < rhs.evaluate(2);
-    }
-
+    static std::mutex exitShardMutex;
+    
     /**
-     * @brief Оператор "больше"
-     * @details Сравнивает значения полиномов в точке x=2
+     * @var static std::atomic<std::uint64_t> PolynomialStatistics::rootSequence
+     * @brief Последний выданный номер вычисления корней
      */
-    friend bool operator>(const Polynomial& lhs, const Polynomial& rhs) {
-        return lhs.evaluate(2) > rhs.evaluate(2);
-    }
-
+    static std::atomic<std::uint64_t> rootSequence;
+    
     /**
-     * @brief Оператор "меньше или равно"
-     * @details Сравнивает значения полиномов в точке x=2
+     * @var static std::atomic<std::uint64_t> PolynomialStatistics::deletionSequence
+     * @brief Последний выданный номер удаления
      */
-    friend bool operator<=(const Polynomial& lhs, const Polynomial& rhs) {
-        return lhs.evaluate(2) <= rhs.evaluate(2);
-    }
-
+    static std::atomic<std::uint64_t> deletionSequence;
+    
     /**
-     * @brief Оператор "больше или равно"
-     * @details Сравнивает значения полиномов в точке x=2
+     * @var static std::pmr::synchronized_pool_resource PolynomialStatistics::sessionArena
+     * @brief Арена сессии: буферы историй и хранилища, выделенные через sessionResource()
+     * @details Пулы потокобезопасны; освобожденные блоки переиспользуются,
+     * а release() в cleanupStaticData() возвращает всю память одним вызовом
      */
-    friend bool operator>=(const Polynomial& lhs, const Polynomial& rhs) {
-        return lhs.evaluate(2) >= rhs.evaluate(2);
-    }
-
+    static std::pmr::synchronized_pool_resource sessionArena;
+    
     /**
-     * @brief Оператор равенства
-     * @details Сравнивает значения полиномов в точке x=2
+     * @var static std::atomic<bool> PolynomialStatistics::latencyTracking
+     * @brief Включен ли замер задержек операций
+     * @details Начальное значение задается переменной окружения POLY_LATENCY
      */
-    friend bool operator==(const Polynomial& lhs, const Polynomial& rhs) {
-        return lhs.evaluate(2) == rhs.evaluate(2);
-    }
-
+    static std::atomic<bool> latencyTracking;
+    
     /**
-     * @brief Оператор неравенства
-     * @details Сравнивает значения полиномов в точке x=2
+     * @var static const std::uint64_t PolynomialStatistics::epochTimestamp
+     * @brief latencyTimestamp() при запуске программы
      */
-    friend bool operator!=(const Polynomial& lhs, const Polynomial& rhs) {
-        return lhs.evaluate(2) != rhs.evaluate(2);
-    }
+    static const std::uint64_t epochTimestamp;
     
-    /** @} */ // конец группы ComparisonOperations
-
     /**
-     * @brief Вычисляет значение полинома в заданной точке
-     * @param x Точка для вычисления
-     * @return Значение полинома в точке x: a*x² + b*x + c
+     * @var static const std::chrono::steady_clock::time_point PolynomialStatistics::epochTime
+     * @brief steady_clock при запуске программы (пара к epochTimestamp)
      */
-    double evaluate(double x) const {
-        return a * x * x + b * x + c;
-    }
-
+    static const std::chrono::steady_clock::time_point epochTime;
+    
     /**
-     * @brief Выводит полином в читаемом формате
-     * @details Формат вывода: "ax^2 + bx + c"
-     * Пример: "3.5x^2 + -2x + 1"
+     * @var static std::atomic<bool> PolynomialStatistics::perfCounting
+     * @brief Включено ли чтение аппаратных счетчиков вокруг пакетов
+     * @details Начальное значение задается переменной окружения POLY_PERF
      */
-    void print() const {
-        std::cout << a << "x^2 + " << b << "x + " << c;
-    }
-
+    static std::atomic<bool> perfCounting;
+    
     /**
-     * @defgroup GetterMethods Геттеры
-     * @brief Методы для получения значений коэффициентов
+     * @var static std::atomic<unsigned> PolynomialStatistics::perfAvailableMask
+     * @brief Объединение масок счетчиков, открытых хотя бы одним потоком
+     */
+    static std::atomic<unsigned> perfAvailableMask;
+    
+    /**
+     * @var static std::atomic<int> PolynomialStatistics::perfOpenError
+     * @brief errno последней неудачной попытки открыть счетчики (0 - не было)
+     */
+    static std::atomic<int> perfOpenError;
+    
+    static std::size_t rootRetention;      ///< Емкость истории вычислений
+    static std::size_t rootSampleEvery;    ///< Прореживание истории вычислений
+    static std::size_t deletedRetention;   ///< Емкость истории удалений
+    static std::size_t deletedSampleEvery; ///< Прореживание истории удалений
+    
+    /**
+     * @var static std::atomic<bool> PolynomialStatistics::programFinished
+     * @brief Флаг завершения программы
+     * @details Используется для определения момента вывода финальной статистики
+     */
+    static std::atomic<bool> programFinished;
+    
+    /**
+     * @brief Увеличивает счетчик, который изменяет только поток-владелец
+     * @param counter Счетчик шарда текущего потока
+     * @private
+     */
+    static void bump(std::atomic<std::uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Закрепляет за текущим потоком свободный или новый шард
+     * @param[out] exitLock Захватывается, если поток уже вернул свой шард
+     * и событие пишется в exitShard
+     * @private
+     */
+    static StatisticsShard& acquireShard(std::unique_lock<std::mutex>& exitLock) {
+        if (leaseReleased) {
+            return lockExitShard(exitLock);
+        }
+        
+        static thread_local ShardLease lease;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        
+        StatisticsShard* shard = shards;
+        while (shard != nullptr && shard->inUse) {
+            shard = shard->next;
+        }
+        if (shard == nullptr) {
+            shard = new StatisticsShard(rootRetention, rootSampleEvery,
+                                        deletedRetention, deletedSampleEvery, &sessionArena);
+            shard->next = shards;
+            shards = shard;
+        }
+        
+        shard->inUse = true;
+        lease.shard = shard;
+        currentShard = shard;
+        return *shard;
+    }
+    
+    /**
+     * @brief Захватывает общий шард для событий завершающихся потоков
+     * @param[out] exitLock Блокировка exitShardMutex
+     * @details Шард помечен занятым, поэтому не закрепляется за потоками и не
+     * удаляется cleanupStaticData(), а его данные учитываются наравне с остальными
+     * @private
+     */
+    static StatisticsShard& lockExitShard(std::unique_lock<std::mutex>& exitLock) {
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            if (exitShard == nullptr) {
+                exitShard = new StatisticsShard(rootRetention, rootSampleEvery,
+                                                deletedRetention, deletedSampleEvery, &sessionArena);
+                exitShard->inUse = true;
+                exitShard->next = shards;
+                shards = exitShard;
+            }
+        }
+        exitLock = std::unique_lock<std::mutex>(exitShardMutex);
+        return *exitShard;
+    }
+    
+    /**
+     * @brief Выдает очередной порядковый номер
+     * @param global Общий счетчик номеров
+     * @return Порядковый номер (начиная с 1)
+     * @details Вызывается под мьютексом истории шарда, поэтому порядок номеров
+     * совпадает с порядком добавления записей в истории
+     * @private
+     */
+    static std::uint64_t takeSequence(std::atomic<std::uint64_t>& global) {
+        return global.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    
+    /**
+     * @brief Суммирует счетчики всех шардов
+     * @private
+     */
+    static Totals mergedTotals() {
+        Totals totals = {0, 0, 0, 0, 0};
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (StatisticsShard* shard = shards; shard != nullptr; shard = shard->next) {
+            totals.instances += shard->instances.load(std::memory_order_relaxed);
+            totals.deletions += shard->deletions.load(std::memory_order_relaxed);
+            totals.rootCalculations += shard->rootCalculations.load(std::memory_order_relaxed);
+            totals.rootCacheHits += shard->rootCacheHits.load(std::memory_order_relaxed);
+            totals.rootCacheMisses += shard->rootCacheMisses.load(std::memory_order_relaxed);
+        }
+        return totals;
+    }
+    
+    /**
+     * @brief Объединяет гистограммы задержек операции по всем шардам
+     * @param operation Операция
+     * @private
+     */
+    static LatencyDistribution mergedLatency(LatencyOperation operation) {
+        LatencyDistribution merged;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (StatisticsShard* shard = shards; shard != nullptr; shard = shard->next) {
+            merged.merge(shard->latency[operation]);
+        }
+        return merged;
+    }
+    
+    /**
+     * @brief Возвращает группу счетчиков текущего потока, открывая ее при первом обращении
+     * @details Дескрипторы perf привязаны к потоку, поэтому группа живет в
+     * thread_local, а не в шарде, который может перейти к другому потоку
+     * @private
+     */
+    static const PerfCounterGroup& threadPerfGroup() {
+        static thread_local PerfCounterGroup group;
+        static thread_local bool published = false;
+        if (!published) {
+            published = true;
+            if (group.available()) {
+                perfAvailableMask.fetch_or(group.availableMask(), std::memory_order_relaxed);
+            } else {
+                perfOpenError.store(group.openError(), std::memory_order_relaxed);
+            }
+        }
+        return group;
+    }
+    
+    /**
+     * @brief Объединяет агрегаты вычислений корней всех шардов
+     * @private
+     */
+    static RootAggregate mergedAggregate() {
+        RootAggregate merged;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (StatisticsShard* shard = shards; shard != nullptr; shard = shard->next) {
+            std::lock_guard<std::mutex> shardLock(shard->historyMutex);
+            merged.merge(shard->rootAggregate);
+        }
+        return merged;
+    }
+    
+    /**
+     * @brief Объединяет истории всех шардов в хронологическом порядке
+     * @tparam Record Тип записи
+     * @param history Указатель на поле истории в StatisticsShard
+     * @param limit Максимальное количество возвращаемых (последних) записей
+     * @return Записи, упорядоченные по порядковому номеру
+     * @private
+     */
+    template <typename Record>
+    static std::vector<Record> mergedHistory(HistoryRing<Record> StatisticsShard::*history,
+                                             std::size_t limit) {
+        std::vector<Record> merged;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (StatisticsShard* shard = shards; shard != nullptr; shard = shard->next) {
+                std::lock_guard<std::mutex> shardLock(shard->historyMutex);
+                const HistoryRing<Record>& ring = shard->*history;
+                for (std::size_t i = 0; i < ring.size(); i++) {
+                    merged.push_back(ring.at(i));
+                }
+            }
+        }
+        
+        std::sort(merged.begin(), merged.end(), [](const Record& lhs, const Record& rhs) {
+            return lhs.sequence < rhs.sequence;
+        });
+        if (merged.size() > limit) {
+            merged.erase(merged.begin(), merged.end() - limit);
+        }
+        return merged;
+    }
+    
+    /**
+     * @brief Формирует текстовое описание удаленного полинома
+     * @param record Двоичная запись об удалении
+     * @return Строка вида "Polynomial #N: ax^2 + bx + c"
+     * @private
+     */
+    static std::string formatDeletedPolynomial(const DeletedPolynomialRecord& record) {
+        return "Polynomial #" + std::to_string(record.sequence) + 
+               ": " + std::to_string(record.a) + "x^2 + " + 
+               std::to_string(record.b) + "x + " + std::to_string(record.c);
+    }
+    
+    /**
+     * @brief Выводит пояснение, если история хранится не полностью
+     * @param stored Количество хранимых записей
+     * @param total Точное количество событий
+     * @param sampleEvery Частота прореживания
+     * @private
+     */
+    static void printRetentionNote(std::size_t stored, std::uint64_t total, std::size_t sampleEvery) {
+        if (stored < total) {
+            std::cout << "(pokazany poslednie " << stored << " iz " << total;
+            if (sampleEvery > 1) {
+                std::cout << ", sohranyaetsya kazhdoe " << sampleEvery << "-e";
+            }
+            std::cout << ")" << std::endl;
+        }
+    }
+    
+    /**
+     * @brief Выводит счетчики кэшей корней, если они использовались
+     * @param totals Объединенные счетчики
+     * @details Доля попаданий считается в double: 100 * hits переполнил бы
+     * uint64_t на очень больших счетчиках
+     * @private
+     */
+    static void printRootCacheSummary(const Totals& totals) {
+        std::uint64_t lookups = totals.rootCacheHits + totals.rootCacheMisses;
+        if (lookups == 0) {
+            return;
+        }
+        double percent = 100.0 * static_cast<double>(totals.rootCacheHits) / static_cast<double>(lookups);
+        std::cout << "Kesh korney: popadaniy " << totals.rootCacheHits
+                  << ", promahov " << totals.rootCacheMisses
+                  << " (" << static_cast<int>(percent) << "%)" << std::endl;
+    }
+    
+    /**
+     * @brief Выводит агрегаты вычислений корней
+     * @param aggregate Объединенные агрегаты
+     * @private
+     */
+    static void printRootAggregate(const RootAggregate& aggregate) {
+        if (aggregate.calculations == 0) {
+            return;
+        }
+        std::cout << "\nAgregaty po vsem vychisleniyam (" << aggregate.calculations << "):" << std::endl;
+        std::cout << "  Dva kornya: " << aggregate.caseCounts[RootAggregate::twoRoots]
+                  << ", odin koren: " << aggregate.caseCounts[RootAggregate::oneRoot]
+                  << ", net deistvitelnih: " << aggregate.caseCounts[RootAggregate::noRealRoots]
+                  << ", lineinyh: " << aggregate.caseCounts[RootAggregate::linear]
+                  << ", constant: " << aggregate.caseCounts[RootAggregate::constant] << std::endl;
+        std::cout << "  Discriminant < 0: " << aggregate.discriminantCounts[RootAggregate::negativeDiscriminant]
+                  << ", = 0: " << aggregate.discriminantCounts[RootAggregate::zeroDiscriminant]
+                  << ", > 0: " << aggregate.discriminantCounts[RootAggregate::positiveDiscriminant];
+        if (aggregate.discriminantCounts[RootAggregate::undefinedDiscriminant] > 0) {
+            std::cout << ", NaN: " << aggregate.discriminantCounts[RootAggregate::undefinedDiscriminant];
+        }
+        std::cout << std::endl;
+        if (aggregate.rootCount > 0) {
+            std::cout << "  Korni (" << aggregate.rootCount << "): min " << aggregate.rootMin
+                      << ", max " << aggregate.rootMax << ", srednee " << aggregate.rootMean
+                      << ", dispersiya " << aggregate.rootVariance() << std::endl;
+            std::cout << "  Kvantili korney: p50 " << aggregate.rootQuantile(0.5)
+                      << ", p90 " << aggregate.rootQuantile(0.9)
+                      << ", p99 " << aggregate.rootQuantile(0.99) << std::endl;
+        }
+    }
+    
+    /**
+     * @brief Возвращает число единиц latencyTimestamp() в наносекунде
+     * @details Отношение приращений TSC и steady_clock с запуска программы;
+     * если с запуска прошло меньше 10 мс, интервал добирается ожиданием
+     * @private
+     */
+    static double ticksPerNanosecond() {
+#if defined(__x86_64__) || defined(__i386__)
+        std::chrono::steady_clock::time_point now;
+        std::uint64_t timestamp;
+        do {
+            now = std::chrono::steady_clock::now();
+            timestamp = latencyTimestamp();
+        } while (now - epochTime < std::chrono::milliseconds(10));
+        return static_cast<double>(timestamp - epochTimestamp) /
+               std::chrono::duration<double, std::nano>(now - epochTime).count();
+#else
+        return 1.0;
+#endif
+    }
+    
+    /**
+     * @brief Выводит перцентили задержек операций, если они замерялись
+     * @private
+     */
+    static void printLatencySummary() {
+        double ticksPerNs = 0.0;
+        auto nanoseconds = [&ticksPerNs](std::uint64_t ticks) {
+            return static_cast<std::uint64_t>(static_cast<double>(ticks) / ticksPerNs + 0.5);
+        };
+        bool headerPrinted = false;
+        for (int i = 0; i < latencyOperationCount; i++) {
+            LatencyOperation operation = static_cast<LatencyOperation>(i);
+            LatencyDistribution distribution = mergedLatency(operation);
+            if (distribution.total == 0) {
+                continue;
+            }
+            if (!headerPrinted) {
+                ticksPerNs = ticksPerNanosecond();
+                std::cout << "\nZaderzhki operaciy (ns):" << std::endl;
+                headerPrinted = true;
+            }
+            std::cout << "  " << latencyOperationName(operation) << ": " << distribution.total
+                      << " vyzovov, p50 " << nanoseconds(distribution.percentile(0.5))
+                      << ", p99 " << nanoseconds(distribution.percentile(0.99))
+                      << ", p999 " << nanoseconds(distribution.percentile(0.999))
+                      << ", max " << nanoseconds(distribution.percentile(1.0)) << std::endl;
+        }
+    }
+    
+    /**
+     * @brief Формирует текстовое описание вычисления корней
+     * @param record Двоичная запись о вычислении
+     * @return Строка вида "Calculation #N for ax^2 + bx + c -> ..."
+     * @private
+     */
+    static std::string formatRootCalculation(const RootCalculationRecord& record) {
+        std::string calcInfo = "Calculation #" + std::to_string(record.sequence) + 
+                              " for " + std::to_string(record.a) + "x^2 + " + 
+                              std::to_string(record.b) + "x + " + std::to_string(record.c);
+        
+        if (record.a == 0) {
+            if (record.numRoots == 1) {
+                calcInfo += " -> Lineinoe uravnenie, koren: " + std::to_string(record.root1);
+            } else {
+                calcInfo += " -> Constant, net kornei";
+            }
+        } else if (record.numRoots == 2) {
+            calcInfo += " -> Dva kornya: " + std::to_string(record.root1) + 
+                       ", " + std::to_string(record.root2);
+        } else if (record.numRoots == 1) {
+            calcInfo += " -> Odin koren: " + std::to_string(record.root1);
+        } else {
+            calcInfo += " -> Net deistvitelnih korney (discriminant < 0)";
+        }
+        
+        return calcInfo;
+    }
+
+    /**
+     * @brief Выводит финальную статистику, если удален последний полином
+     * @private
+     */
+    static void checkProgramFinished() {
+        if (programFinished.load(std::memory_order_relaxed)) {
+            Totals totals = mergedTotals();
+            if (totals.deletions == totals.instances) {
+                printFinalStatistics();
+            }
+        }
+    }
+
+public:
+    /**
+     * @defgroup StatisticsRecording Регистрация событий
+     * @brief Методы, вызываемые политиками статистики
+     * @details Все методы пишут только в шард текущего потока
      * @{
      */
     
     /**
-     * @brief Возвращает коэффициент a
-     * @return Коэффициент при x²
+     * @brief Учитывает создание экземпляра
+     * @post Увеличивает счетчик экземпляров на 1
+     */
+    static void countInstance() {
+        bump(LocalShard()->instances);
+    }
+    
+    /**
+     * @brief Учитывает удаление экземпляра без сохранения записи
+     * @post При завершении программы выводит финальную статистику
+     */
+    static void countDeletion() {
+        bump(LocalShard()->deletions);
+        checkProgramFinished();
+    }
+    
+    /**
+     * @brief Учитывает удаление экземпляра и сохраняет запись о нем
+     * @param a Коэффициент при x²
+     * @param b Коэффициент при x
+     * @param c Свободный член
+     * @post При завершении программы выводит финальную статистику
+     */
+    static void recordDeletion(double a, double b, double c) {
+        LocalShard local;
+        StatisticsShard& shard = *local;
+        bump(shard.deletions);
+        {
+            std::lock_guard<std::mutex> lock(shard.historyMutex);
+            DeletedPolynomialRecord record;
+            record.sequence = takeSequence(deletionSequence);
+            record.a = a;
+            record.b = b;
+            record.c = c;
+            shard.deletedHistory.push(record);
+        }
+        
+        checkProgramFinished();
+    }
+    
+    /**
+     * @brief Учитывает вычисление корней без сохранения записи
+     */
+    static void countRootCalculation() {
+        bump(LocalShard()->rootCalculations);
+    }
+    
+    /**
+     * @brief Учитывает вычисление корней и сохраняет двоичную запись о нем
+     * @param a Коэффициент при x²
+     * @param b Коэффициент при x
+     * @param c Свободный член
+     * @param root1 Первый корень (если существует)
+     * @param root2 Второй корень (если существует)
+     * @param numRoots Количество действительных корней
+     * @details Текст записи формируется только при выводе статистики.
+     * Агрегаты обновляются при каждом вызове, независимо от прореживания истории
+     */
+    static void recordRootCalculation(double a, double b, double c,
+                                      double root1, double root2, int numRoots) {
+        LocalShard local;
+        StatisticsShard& shard = *local;
+        bump(shard.rootCalculations);
+        
+        std::lock_guard<std::mutex> lock(shard.historyMutex);
+        RootCalculationRecord record;
+        record.sequence = takeSequence(rootSequence);
+        record.a = a;
+        record.b = b;
+        record.c = c;
+        record.root1 = numRoots > 0 ? root1 : NAN;
+        record.root2 = numRoots > 1 ? root2 : NAN;
+        record.numRoots = numRoots;
+        shard.rootHistory.push(record);
+        shard.rootAggregate.add(a, b, c, root1, root2, numRoots);
+    }
+    
+    /**
+     * @brief Резервирует непрерывный диапазон номеров вычислений корней
+     * @param count Количество резервируемых номеров
+     * @return Первый номер диапазона
+     * @details Используется для детерминированной нумерации пакетных вычислений:
+     * i-й элемент пакета получает номер firstSequence + i независимо от того,
+     * какой поток его обработал. Номера отражают момент резервирования: в
+     * объединенной истории весь пакет стоит перед вычислениями, начатыми позже
+     */
+    static std::uint64_t reserveRootSequences(std::uint64_t count) {
+        return rootSequence.fetch_add(count, std::memory_order_relaxed) + 1;
+    }
+    
+    /**
+     * @brief Сохраняет записи о пакете вычислений корней
+     * @param a Коэффициенты при x²
+     * @param b Коэффициенты при x
+     * @param c Свободные члены
+     * @param root1 Первые корни (NaN, если корня нет)
+     * @param root2 Вторые корни (NaN, если корня нет)
+     * @param numRoots Количества корней
+     * @param count Размер пакета
+     * @param firstSequence Номер первого элемента из reserveRootSequences()
+     * или 0, чтобы зарезервировать номера для пакета сейчас
+     * @details Счетчик и мьютекс шарда затрагиваются один раз на весь пакет
+     */
+    static void recordRootCalculations(const double* a, const double* b, const double* c,
+                                       const double* root1, const double* root2, const int* numRoots,
+                                       std::size_t count, std::uint64_t firstSequence = 0) {
+        LocalShard local;
+        StatisticsShard& shard = *local;
+        shard.rootCalculations.store(shard.rootCalculations.load(std::memory_order_relaxed) + count,
+                                     std::memory_order_relaxed);
+        
+        std::lock_guard<std::mutex> lock(shard.historyMutex);
+        if (firstSequence == 0) {
+            firstSequence = reserveRootSequences(count);
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            RootCalculationRecord record;
+            record.sequence = firstSequence + i;
+            record.a = a[i];
+            record.b = b[i];
+            record.c = c[i];
+            record.root1 = root1[i];
+            record.root2 = root2[i];
+            record.numRoots = numRoots[i];
+            shard.rootHistory.push(record);
+            shard.rootAggregate.add(a[i], b[i], c[i], root1[i], root2[i], numRoots[i]);
+        }
+    }
+    
+    /**
+     * @brief Учитывает обращение к кэшу корней (RootCache или CachedRoots)
+     * @param hit true - результат найден в кэше, false - промах
+     * @details Попадание не считается вычислением корней и не попадает в
+     * историю: вычислением считается только промах, при котором кэш вызывает
+     * findRoots() полинома
+     */
+    static void countRootCacheLookup(bool hit) {
+        LocalShard local;
+        StatisticsShard& shard = *local;
+        bump(hit ? shard.rootCacheHits : shard.rootCacheMisses);
+    }
+    
+    /**
+     * @brief Начинает замер задержки операции
+     * @return Момент начала (latencyTimestamp()) или 0, если замер выключен
+     * @details При выключенном замере стоит одного чтения флага
+     */
+    static std::uint64_t latencyStart() {
+        if (!latencyTracking.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        return latencyTimestamp();
+    }
+    
+    /**
+     * @brief Завершает замер и учитывает задержку в гистограмме потока
+     * @param operation Операция
+     * @param started Результат latencyStart() (0 - замер не начинался)
+     */
+    static void recordLatency(LatencyOperation operation, std::uint64_t started) {
+        if (started == 0) {
+            return;
+        }
+        LocalShard()->latency[operation].record(latencyTimestamp() - started);
+    }
+    
+    /** @} */ // конец группы StatisticsRecording
+    
+    /**
+     * @brief Устанавливает флаг завершения программы
+     * @param finished true - программа завершена, false - программа работает
+     */
+    static void setProgramFinished(bool finished) {
+        programFinished.store(finished, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Начинает измерение пакета аппаратными счетчиками
+     * @param[out] sample Показания в начале пакета
+     * @return true, если измерение включено и счетчики прочитаны
+     * @details При выключенном измерении стоит одного чтения флага
+     */
+    static bool perfStart(PerfSample& sample) {
+        if (!perfCounting.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        return threadPerfGroup().read(sample);
+    }
+    
+    /**
+     * @brief Завершает измерение пакета и добавляет приращения в шард потока
+     * @param operation Пакетная операция
+     * @param items Количество элементов пакета
+     * @param start Показания из perfStart()
+     */
+    static void recordPerf(PerfOperation operation, std::size_t items, const PerfSample& start) {
+        PerfSample finish;
+        if (!threadPerfGroup().read(finish)) {
+            return;
+        }
+        std::uint64_t enabled = finish.timeEnabled - start.timeEnabled;
+        std::uint64_t running = finish.timeRunning - start.timeRunning;
+        // Группа была на PMU только часть интервала - приращения экстраполируются
+        double scale = (running > 0 && running < enabled)
+            ? static_cast<double>(enabled) / static_cast<double>(running) : 1.0;
+        
+        LocalShard local;
+        PerfCounterTotals& totals = local->perf[operation];
+        bump(totals.batches);
+        totals.items.store(totals.items.load(std::memory_order_relaxed) + items,
+                           std::memory_order_relaxed);
+        for (int i = 0; i < perfCounterCount; i++) {
+            std::uint64_t delta = static_cast<std::uint64_t>(
+                static_cast<double>(finish.values[i] - start.values[i]) * scale + 0.5);
+            totals.counters[i].store(totals.counters[i].load(std::memory_order_relaxed) + delta,
+                                     std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * @brief Включает или выключает чтение аппаратных счетчиков вокруг пакетов
+     * @param enabled true - измерять пакеты findRoots и evaluate
+     * @details Счетчики потока открываются при первом измеренном пакете;
+     * если perf_event_open недоступен, пакеты выполняются без измерения
+     */
+    static void setPerfCounters(bool enabled) {
+        perfCounting.store(enabled, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Проверяет, включено ли чтение аппаратных счетчиков
+     */
+    static bool isPerfCounting() {
+        return perfCounting.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Выводит показания аппаратных счетчиков в расчете на элемент
+     * @param out Поток вывода
+     * @details Ничего не выводит, если пакеты не измерялись и измерение выключено
+     */
+    static void printPerfCounterSummary(std::ostream& out) {
+        std::uint64_t batches[perfOperationCount] = {};
+        std::uint64_t items[perfOperationCount] = {};
+        std::uint64_t counters[perfOperationCount][perfCounterCount] = {};
+        bool measured = false;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (StatisticsShard* shard = shards; shard != nullptr; shard = shard->next) {
+                for (int op = 0; op < perfOperationCount; op++) {
+                    const PerfCounterTotals& totals = shard->perf[op];
+                    batches[op] += totals.batches.load(std::memory_order_relaxed);
+                    items[op] += totals.items.load(std::memory_order_relaxed);
+                    for (int i = 0; i < perfCounterCount; i++) {
+                        counters[op][i] += totals.counters[i].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+        for (int op = 0; op < perfOperationCount; op++) {
+            measured = measured || batches[op] > 0;
+        }
+        
+        int error = perfOpenError.load(std::memory_order_relaxed);
+        if (!measured) {
+            if (perfCounting.load(std::memory_order_relaxed) && error != 0) {
+                out << "\nSchetchiki processora nedostupny: " << std::strerror(error) << std::endl;
+            }
+            return;
+        }
+        
+        unsigned mask = perfAvailableMask.load(std::memory_order_relaxed);
+        out << "\nSchetchiki processora (perf_event, na element):" << std::endl;
+        for (int op = 0; op < perfOperationCount; op++) {
+            if (batches[op] == 0) {
+                continue;
+            }
+            double perItem = items[op] > 0 ? 1.0 / static_cast<double>(items[op]) : 0.0;
+            out << "  " << perfOperationName(static_cast<PerfOperation>(op)) << ": "
+                << batches[op] << " paketov, " << items[op] << " elementov";
+            for (int i = 0; i < perfCounterCount; i++) {
+                out << ", " << perfCounterName(static_cast<PerfCounter>(i)) << " ";
+                if (mask & (1u << i)) {
+                    out << static_cast<double>(counters[op][i]) * perItem;
+                } else {
+                    out << "n/a";
+                }
+            }
+            if ((mask & (1u << cyclesCounter)) && (mask & (1u << instructionsCounter)) &&
+                counters[op][cyclesCounter] > 0) {
+                out << ", IPC " << static_cast<double>(counters[op][instructionsCounter]) /
+                                   static_cast<double>(counters[op][cyclesCounter]);
+            }
+            out << std::endl;
+        }
+    }
+    
+    /**
+     * @brief Включает или выключает замер задержек операций
+     * @param enabled true - вести гистограммы задержек
+     * @details Накопленные гистограммы сохраняются; замеры, начатые до
+     * выключения, завершаются обычным образом
+     */
+    static void setLatencyTracking(bool enabled) {
+        latencyTracking.store(enabled, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Проверяет, включен ли замер задержек
+     */
+    static bool isLatencyTracking() {
+        return latencyTracking.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Задает политику хранения истории вычислений корней
+     * @param maxEntries Количество хранимых последних записей
+     * @param sampleEvery Сохранять каждое sampleEvery-е вычисление (1 - все)
+     * @details Счетчик вычислений остается точным независимо от политики.
+     * Политика действует для истории каждого потока.
+     */
+    static void setRootCalculationRetention(std::size_t maxEntries, std::size_t sampleEvery = 1) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        rootRetention = maxEntries;
+        rootSampleEvery = (sampleEvery == 0) ? 1 : sampleEvery;
+        for (StatisticsShard* shard = shards; shard != nullptr; shard = shard->next) {
+            std::lock_guard<std::mutex> shardLock(shard->historyMutex);
+            shard->rootHistory.configure(rootRetention, rootSampleEvery);
+        }
+    }
+    
+    /**
+     * @brief Задает политику хранения истории удаленных полиномов
+     * @param maxEntries Количество хранимых последних записей
+     * @param sampleEvery Сохранять каждое sampleEvery-е удаление (1 - все)
+     * @details Счетчик удалений остается точным независимо от политики.
+     * Политика действует для истории каждого потока.
+     */
+    static void setDeletedPolynomialRetention(std::size_t maxEntries, std::size_t sampleEvery = 1) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        deletedRetention = maxEntries;
+        deletedSampleEvery = (sampleEvery == 0) ? 1 : sampleEvery;
+        for (StatisticsShard* shard = shards; shard != nullptr; shard = shard->next) {
+            std::lock_guard<std::mutex> shardLock(shard->historyMutex);
+            shard->deletedHistory.configure(deletedRetention, deletedSampleEvery);
+        }
+    }
+    
+    /**
+     * @brief Выводит статистику вычисления корней
+     * @details Показывает:
+     * - Общее количество вычислений корней
+     * - Агрегаты по всем вычислениям (классы, знак дискриминанта, моменты и квантили корней)
+     * - Перцентили задержек операций, если замер включался
+     * - Аппаратные счетчики пакетов, если их чтение включалось
+     * - Последнее вычисление
+     * - Предыдущее вычисление
+     * - Все вычисления в хронологическом порядке
+     */
+    static void showRootCalculationStats() {
+        Totals totals = mergedTotals();
+        std::uint64_t total = totals.rootCalculations;
+        std::vector<RootCalculationRecord> history =
+            mergedHistory(&StatisticsShard::rootHistory, rootRetention);
+        
+        std::cout << "\n" << std::string(40, '=') << std::endl;
+        std::cout << "  STATISTIKA VYCHISLENIYA KORNEY" << std::endl;
+        std::cout << std::string(40, '=') << std::endl;
+        
+        std::cout << "Vsego vychisleniy korney s nachala programmy: " 
+                  << total << std::endl;
+        printRootCacheSummary(totals);
+        printRootAggregate(mergedAggregate());
+        printLatencySummary();
+        printPerfCounterSummary(std::cout);
+        
+        std::size_t stored = history.size();
+        if (stored > 0) {
+            std::cout << "\nPoslednee vychislenie:" << std::endl;
+            std::cout << formatRootCalculation(history[stored - 1]) << std::endl;
+            
+            if (stored > 1) {
+                std::cout << "\nPredydushchee vychislenie:" << std::endl;
+                std::cout << formatRootCalculation(history[stored - 2]) << std::endl;
+            }
+            
+            std::cout << "\nVse vychisleniya (" << stored << "):" << std::endl;
+            printRetentionNote(stored, total, rootSampleEvery);
+            for (std::size_t i = 0; i < stored; i++) {
+                std::cout << i+1 << ". " << formatRootCalculation(history[i]) << std::endl;
+            }
+        } else if (total > 0) {
+            std::cout << "\nIstoriya vychisleniy ne hranitsya." << std::endl;
+        } else {
+            std::cout << "\nFunkciya poiska korney eshche ne ispolzovalas." << std::endl;
+        }
+        
+        std::cout << std::string(40, '=') << std::endl;
+    }
+    
+    /**
+     * @brief Выводит финальную статистику программы
+     * @details Вызывается автоматически при завершении программы
+     * Показывает:
+     * - Все удаленные полиномы
+     * - Все вычисления корней
+     * - Итоговую статистику, перцентили задержек и аппаратные счетчики
+     */
+    static void printFinalStatistics() {
+        Totals totals = mergedTotals();
+        
+        std::cout << "\n" << std::string(50, '=') << std::endl;
+        std::cout << "          FINAL STATISTICS" << std::endl;
+        std::cout << std::string(50, '=') << std::endl;
+        
+        std::cout << "\n=== ALL DELETED POLYNOMIALS ===" << std::endl;
+        if (totals.deletions == 0) {
+            std::cout << "No polynomials were deleted." << std::endl;
+        } else {
+            std::vector<DeletedPolynomialRecord> history =
+                mergedHistory(&StatisticsShard::deletedHistory, deletedRetention);
+            printRetentionNote(history.size(), totals.deletions, deletedSampleEvery);
+            for (std::size_t i = 0; i < history.size(); i++) {
+                std::cout << i+1 << ". " << formatDeletedPolynomial(history[i]) << std::endl;
+            }
+            std::cout << "\nTotal deleted polynomials: " << totals.deletions << std::endl;
+        }
+        
+        std::cout << "\n=== ROOT CALCULATIONS SUMMARY ===" << std::endl;
+        if (totals.rootCalculations == 0) {
+            std::cout << "Ni odnogo kornya ne bili vichisleni." << std::endl;
+        } else {
+            std::vector<RootCalculationRecord> history =
+                mergedHistory(&StatisticsShard::rootHistory, rootRetention);
+            printRetentionNote(history.size(), totals.rootCalculations, rootSampleEvery);
+            for (std::size_t i = 0; i < history.size(); i++) {
+                std::cout << i+1 << ". " << formatRootCalculation(history[i]) << std::endl;
+            }
+            std::cout << "\nTotal root calculations: " << totals.rootCalculations << std::endl;
+        }
+        printRootCacheSummary(totals);
+        printLatencySummary();
+        printPerfCounterSummary(std::cout);
+        
+        std::cout << std::string(50, '=') << std::endl;
+    }
+    
+    /**
+     * @brief Очищает все статические данные класса
+     * @details Освобождает истории и шарды завершившихся потоков, сбрасывает
+     * счетчики и нумерацию, возвращает всю память арены сессии
+     * @pre Другие потоки не регистрируют события: завершены или ожидают.
+     * Владельцы изменяют счетчики шардов чтением и записью без
+     * read-modify-write, поэтому одновременный сброс мог бы потеряться
+     * @warning Должен вызываться только при завершении программы, когда другие
+     * потоки уже не работают с полиномами, а хранилища на арене сессии
+     * очищены или больше не используются
+     */
+    static void cleanupStaticData() {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        
+        StatisticsShard** link = &shards;
+        while (*link != nullptr) {
+            StatisticsShard* shard = *link;
+            if (!shard->inUse) {
+                *link = shard->next;
+                delete shard;
+                continue;
+            }
+            
+            std::lock_guard<std::mutex> shardLock(shard->historyMutex);
+            shard->instances.store(0, std::memory_order_relaxed);
+            shard->deletions.store(0, std::memory_order_relaxed);
+            shard->rootCalculations.store(0, std::memory_order_relaxed);
+            shard->rootCacheHits.store(0, std::memory_order_relaxed);
+            shard->rootCacheMisses.store(0, std::memory_order_relaxed);
+            shard->deletedHistory.release();
+            shard->rootHistory.release();
+            shard->rootAggregate.reset();
+            for (LatencyHistogram& histogram : shard->latency) {
+                histogram.reset();
+            }
+            for (PerfCounterTotals& totals : shard->perf) {
+                totals.reset();
+            }
+            link = &shard->next;
+        }
+        
+        // Буферы историй уже возвращены; остальное (хранилища на арене)
+        // освобождается без обхода отдельных блоков
+        sessionArena.release();
+        rootSequence.store(0, std::memory_order_relaxed);
+        deletionSequence.store(0, std::memory_order_relaxed);
+        programFinished.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Возвращает арену сессии
+     * @return Потокобезопасный ресурс памяти, живущий до cleanupStaticData()
+     * @details Передается хранилищам (например, PolynomialArray), которые
+     * растут в течение всей сессии: их блоки переиспользуются пулами и
+     * освобождаются вместе с историями статистики
+     */
+    static std::pmr::memory_resource* sessionResource() {
+        return &sessionArena;
+    }
+
+    /**
+     * @brief Возвращает количество вычислений корней
+     * @return Количество вызовов findRoots() во всех потоках
+     */
+    static int getRootCalculationCount() {
+        return static_cast<int>(mergedTotals().rootCalculations);
+    }
+
+    /**
+     * @brief Возвращает агрегаты вычислений корней
+     * @return Объединенные по всем потокам счетчики классов, гистограмма
+     * знака дискриминанта, моменты и скетч квантилей корней
+     * @details Учитываются вычисления с полной статистикой; отдельные записи
+     * для этого не хранятся
+     */
+    static RootAggregate getRootAggregate() {
+        return mergedAggregate();
+    }
+
+    /**
+     * @brief Возвращает количество попаданий в кэши корней
+     */
+    static std::uint64_t getRootCacheHits() {
+        return mergedTotals().rootCacheHits;
+    }
+    
+    /**
+     * @brief Возвращает количество промахов кэшей корней
+     */
+    static std::uint64_t getRootCacheMisses() {
+        return mergedTotals().rootCacheMisses;
+    }
+
+    /**
+     * @brief Возвращает количество созданных экземпляров
+     * @return Общее количество созданных полиномов с учетом экземпляров во всех потоках
+     */
+    static int getInstanceCount() {
+        return static_cast<int>(mergedTotals().instances);
+    }
+
+    /**
+     * @brief Сбрасывает всю статистику
+     * @details Очищает все статические данные и сбрасывает счетчики
+     * @pre Как у cleanupStaticData(): другие потоки не регистрируют события
+     */
+    static void resetStatistics() {
+        cleanupStaticData();
+    }
+    
+};
+
+/**
+ * @class PerfCounterScope
+ * @brief Измеряет пакет аппаратными счетчиками на время своей жизни
+ * 
+ * @details
+ * Создается вокруг пакета findRoots() или evaluate(); при выключенном
+ * измерении ничего не читает. Одно измерение - два системных вызова read(),
+ * поэтому области ставятся вокруг пакетов, а не отдельных вызовов.
+ * Пример: обход Polynomial::findRoots() по вектору объектов
+ * @code
+ * {
+ *     PerfCounterScope scope(findRootsPerf, polynomials.size());
+ *     for (Polynomial& p : polynomials) p.findRoots(root1, root2, numRoots);
+ * }
+ * @endcode
+ */
+class PerfCounterScope {
+public:
+    /**
+     * @brief Начинает измерение
+     * @param measured Пакетная операция
+     * @param itemCount Количество элементов пакета
+     */
+    PerfCounterScope(PerfOperation measured, std::size_t itemCount)
+        : operation(measured), items(itemCount), active(PolynomialStatistics::perfStart(start)) {}
+    
+    PerfCounterScope(const PerfCounterScope&) = delete;
+    PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+    
+    /**
+     * @brief Завершает измерение и учитывает его в статистике потока
+     */
+    ~PerfCounterScope() {
+        if (active) {
+            PolynomialStatistics::recordPerf(operation, items, start);
+        }
+    }
+    
+private:
+    PerfOperation operation;    ///< Измеряемая операция
+    std::size_t items;          ///< Размер пакета
+    PerfSample start;           ///< Показания в начале пакета
+    bool active;                ///< Было ли начато измерение
+};
+
+/**
+ * @defgroup StatisticsPolicies Политики статистики
+ * @brief Параметры шаблона BasicPolynomial, задающие объем инструментирования
+ * @details Выбор политики происходит при компиляции, поэтому отключенная
+ * статистика не стоит ничего во время выполнения
+ * @{
+ */
+
+/**
+ * @struct NoStatistics
+ * @brief Политика без статистики
+ * @details Полином с этой политикой тривиально копируемый и тривиально
+ * разрушаемый, а его операции сводятся к арифметике над коэффициентами
+ */
+struct NoStatistics {
+    static constexpr bool tracksLifecycle = false; ///< Учитываются ли создание и удаление
+    
+    // Пустые хуки constexpr, чтобы PlainPolynomial работал в константных выражениях
+    static constexpr void onConstruct() {}
+    static constexpr void onDestroy(double, double, double) {}
+    static constexpr void onRootCalculation(double, double, double, double, double, int) {}
+    static constexpr void onRootCacheLookup(bool) {}
+    static constexpr std::uint64_t latencyStart() { return 0; }
+    static constexpr void onLatency(LatencyOperation, std::uint64_t) {}
+};
+
+/**
+ * @struct CountingStatistics
+ * @brief Политика, ведущая только счетчики
+ * @details Учитывает создание, удаление и вычисление корней без записей в истории;
+ * при включенном замере ведет гистограммы задержек
+ */
+struct CountingStatistics {
+    static constexpr bool tracksLifecycle = true; ///< Учитываются ли создание и удаление
+    
+    static void onConstruct() {
+        PolynomialStatistics::countInstance();
+    }
+    
+    static void onDestroy(double, double, double) {
+        PolynomialStatistics::countDeletion();
+    }
+    
+    static void onRootCalculation(double, double, double, double, double, int) {
+        PolynomialStatistics::countRootCalculation();
+    }
+    
+    static void onRootCacheLookup(bool hit) {
+        PolynomialStatistics::countRootCacheLookup(hit);
+    }
+    
+    static std::uint64_t latencyStart() {
+        return PolynomialStatistics::latencyStart();
+    }
+    
+    static void onLatency(LatencyOperation operation, std::uint64_t started) {
+        PolynomialStatistics::recordLatency(operation, started);
+    }
+};
+
+/**
+ * @struct FullStatistics
+ * @brief Политика с полной статистикой
+ * @details Ведет счетчики и историю удаленных полиномов и вычислений корней;
+ * при включенном замере ведет гистограммы задержек
+ */
+struct FullStatistics {
+    static constexpr bool tracksLifecycle = true; ///< Учитываются ли создание и удаление
+    
+    static void onConstruct() {
+        PolynomialStatistics::countInstance();
+    }
+    
+    static void onDestroy(double a, double b, double c) {
+        PolynomialStatistics::recordDeletion(a, b, c);
+    }
+    
+    static void onRootCalculation(double a, double b, double c,
+                                  double root1, double root2, int numRoots) {
+        PolynomialStatistics::recordRootCalculation(a, b, c, root1, root2, numRoots);
+    }
+    
+    static void onRootCacheLookup(bool hit) {
+        PolynomialStatistics::countRootCacheLookup(hit);
+    }
+    
+    static std::uint64_t latencyStart() {
+        return PolynomialStatistics::latencyStart();
+    }
+    
+    static void onLatency(LatencyOperation operation, std::uint64_t started) {
+        PolynomialStatistics::recordLatency(operation, started);
+    }
+};
+
+/**
+ * @struct ViewStatistics
+ * @brief Политика для представлений элементов хранилищ
+ * @details Представление - не новый полином, а копия коэффициентов элемента
+ * (см. BasicPolynomialArray::view()), поэтому создание и удаление не
+ * учитываются. Вычисления корней и задержки записываются как у FullStatistics
+ */
+struct ViewStatistics {
+    static constexpr bool tracksLifecycle = false; ///< Учитываются ли создание и удаление
+    
+    static constexpr void onConstruct() {}
+    static constexpr void onDestroy(double, double, double) {}
+    
+    static void onRootCalculation(double a, double b, double c,
+                                  double root1, double root2, int numRoots) {
+        PolynomialStatistics::recordRootCalculation(a, b, c, root1, root2, numRoots);
+    }
+    
+    static void onRootCacheLookup(bool hit) {
+        PolynomialStatistics::countRootCacheLookup(hit);
+    }
+    
+    static std::uint64_t latencyStart() {
+        return PolynomialStatistics::latencyStart();
+    }
+    
+    static void onLatency(LatencyOperation operation, std::uint64_t started) {
+        PolynomialStatistics::recordLatency(operation, started);
+    }
+};
+
+/** @} */ // конец группы StatisticsPolicies
+
+/** @} */ // конец группы Statistics
+
+/**
+ * @defgroup PolynomialClass Класс Polynomial
+ * @brief Основной класс для работы с квадратными полиномами
+ * @{
+ */
+
+/**
+ * @struct MixedPrecision
+ * @brief Параметр точности: коэффициенты во float, вычисления в double
+ * @details Вдвое уменьшает объем хранимых коэффициентов, но дискриминант
+ * и корни считаются в double, поэтому близкие корни не теряют точность
+ */
+struct MixedPrecision {};
+
+/**
+ * @struct PrecisionTraits
+ * @brief Типы хранения и вычисления для параметра точности BasicPolynomial
+ * @tparam Precision float, double, long double или MixedPrecision
+ */
+template <typename Precision>
+struct PrecisionTraits {
+    typedef Precision Storage;  ///< Тип коэффициентов
+    typedef Precision Compute;  ///< Тип дискриминанта, корней и значений
+};
+
+/**
+ * @brief Смешанная точность: хранение во float, вычисления в double
+ */
+template <>
+struct PrecisionTraits<MixedPrecision> {
+    typedef float Storage;      ///< Тип коэффициентов
+    typedef double Compute;     ///< Тип дискриминанта, корней и значений
+};
+
+/**
+ * @brief Проверяет, что значение конечно (не бесконечность и не NaN)
+ * @details Замена std::isfinite, допустимая в константных выражениях
+ */
+template <typename T>
+constexpr bool isFiniteValue(T x) {
+    return x - x == 0;
+}
+
+/**
+ * @brief Квадратный корень, вычислимый при компиляции
+ * @param x Неотрицательное число
+ * @return Корень x (NaN для отрицательных x и NaN)
+ * @details Во время выполнения вызывает std::sqrt. В константном выражении
+ * аргумент приводится степенями 4 к отрезку [1, 4), корень находится методом
+ * Ньютона и уточняется по точному остатку x - y² (разбиение Деккера), после
+ * чего масштаб возвращается точным умножением на степень двойки.
+ */
+template <typename T>
+constexpr T squareRoot(T x) {
+#if defined(__GNUC__) || defined(__clang__)
+    if (!__builtin_is_constant_evaluated()) {
+        return std::sqrt(x);
+    }
+#endif
+    if (!(x >= 0)) {
+        return NAN;
+    }
+    if (x == 0 || !isFiniteValue(x)) {
+        return x;
+    }
+    T scaled = x;
+    T factor = 1;
+    while (scaled >= 4) {
+        scaled /= 4;
+        factor *= 2;
+    }
+    while (scaled < 1) {
+        scaled *= 4;
+        factor /= 2;
+    }
+    // Начальное приближение не меньше корня, поэтому Ньютон убывает до неподвижной точки
+    T y = (1 + scaled) / 2;
+    for (int i = 0; i < 64; i++) {
+        T next = (y + scaled / y) / 2;
+        if (next >= y) {
+            break;
+        }
+        y = next;
+    }
+    // Один шаг коррекции по точному остатку дает правильно округленный корень
+    const T splitter = T(std::uint64_t(1) << ((std::numeric_limits<T>::digits + 1) / 2)) + 1;
+    T product = y * y;
+    T spread = splitter * y;
+    T high = spread - (spread - y);
+    T low = y - high;
+    T productError = ((high * high - product) + 2 * high * low) + low * low;
+    T residual = (scaled - product) - productError;
+    y += residual / (2 * y);
+    return y * factor;
+}
+
+/**
+ * @struct QuadraticRoots
+ * @brief Корни квадратного уравнения одним значением (см. BasicPolynomial::roots())
+ * @tparam T Тип корней
+ */
+template <typename T>
+struct QuadraticRoots {
+    T root1;    ///< Первый корень (NaN, если корня нет)
+    T root2;    ///< Второй корень (NaN, если корня нет)
+    int count;  ///< Количество действительных корней (0, 1 или 2)
+};
+
+/**
+ * @struct ComplexRootPair
+ * @brief Пара корней квадратного уравнения, действительных или комплексно-сопряженных
+ * @tparam T Тип компонент
+ * @details При отрицательном дискриминанте корни real1 ± i*imag1 (imag1 > 0,
+ * imag2 = -imag1), иначе imag1 = imag2 = 0. См. BasicPolynomial::complexRoots()
+ */
+template <typename T>
+struct ComplexRootPair {
+    T real1;    ///< Действительная часть первого корня
+    T imag1;    ///< Мнимая часть первого корня
+    T real2;    ///< Действительная часть второго корня
+    T imag2;    ///< Мнимая часть второго корня
+};
+
+/**
+ * @class PolynomialCoefficients
+ * @brief Коэффициенты полинома и учет его жизненного цикла
+ * @tparam StatsPolicy Политика статистики
+ * @tparam Scalar Тип коэффициентов
+ * @tparam Trivial true, если политика не отслеживает создание и удаление
+ * 
+ * @details
+ * Общий вариант вызывает хуки политики в конструкторах и деструкторе.
+ * Специализация для Trivial = true не объявляет копирующий конструктор и
+ * деструктор, поэтому BasicPolynomial с такой политикой остается тривиальным.
+ */
+template <typename StatsPolicy, typename Scalar = double, bool Trivial = !StatsPolicy::tracksLifecycle>
+class PolynomialCoefficients {
+protected:
+    Scalar a; ///< Коэффициент при x²
+    Scalar b; ///< Коэффициент при x
+    Scalar c; ///< Свободный член
+    
+    PolynomialCoefficients(Scalar a_val, Scalar b_val, Scalar c_val)
+        : a(a_val), b(b_val), c(c_val) {
+        StatsPolicy::onConstruct();
+    }
+    
+    PolynomialCoefficients(const PolynomialCoefficients& other)
+        : a(other.a), b(other.b), c(other.c) {
+        StatsPolicy::onConstruct();
+    }
+    
+    PolynomialCoefficients& operator=(const PolynomialCoefficients& other) = default;
+    
+    ~PolynomialCoefficients() {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        StatsPolicy::onDestroy(a, b, c);
+        StatsPolicy::onLatency(destroyLatency, started);
+    }
+};
+
+/**
+ * @brief Специализация без учета жизненного цикла
+ */
+template <typename StatsPolicy, typename Scalar>
+class PolynomialCoefficients<StatsPolicy, Scalar, true> {
+protected:
+    Scalar a; ///< Коэффициент при x²
+    Scalar b; ///< Коэффициент при x
+    Scalar c; ///< Свободный член
+    
+    constexpr PolynomialCoefficients(Scalar a_val, Scalar b_val, Scalar c_val)
+        : a(a_val), b(b_val), c(c_val) {}
+};
+
+void evaluatePointsBatch(double a, double b, double c, const double* x, std::size_t n, double* out);
+void evaluatePointsBatch(float a, float b, float c, const float* x, std::size_t n, float* out);
+void evaluatePointsBatch(long double a, long double b, long double c, const long double* x,
+                         std::size_t n, long double* out);
+
+template <typename Derived>
+struct PolynomialExpression;
+
+/**
+ * @class BasicPolynomial
+ * @brief Класс для представления квадратного полинома вида ax² + bx + c
+ * @tparam StatsPolicy Политика статистики: NoStatistics, CountingStatistics
+ * или FullStatistics
+ * @tparam Precision Точность: float, double, long double или MixedPrecision
+ * (см. PrecisionTraits)
+ * Класс инкапсулирует коэффициенты квадратного полинома и предоставляет:
+ * - Арифметические операции (+, -, *, /, +=, -=, *=, /=)
+ * - Операции инкремента/декремента (++, --)
+ * - Операции сравнения (<, >, <=, >=, ==, !=)
+ * - Вычисление корней уравнения
+ * - Вычисление значения полинома в точке
+ * - Статистику использования класса (в зависимости от политики)
+ * 
+ * @note Копирующий конструктор, присваивание и деструктор неявные: учет
+ * экземпляров выполняет базовый класс PolynomialCoefficients
+ * @note Без учета жизненного цикла (PlainPolynomial) конструкторы, evaluate(),
+ * roots(), findRoots() и арифметические операторы вычислимы при компиляции
+ */
+template <typename StatsPolicy = FullStatistics, typename Precision = double>
+class BasicPolynomial : private PolynomialCoefficients<StatsPolicy, typename PrecisionTraits<Precision>::Storage> {
+public:
+    typedef typename PrecisionTraits<Precision>::Storage Scalar;   ///< Тип коэффициентов
+    typedef typename PrecisionTraits<Precision>::Compute Compute;  ///< Тип вычислений и корней
+
+private:
+    typedef PolynomialCoefficients<StatsPolicy, Scalar> Base;
+    
+    using Base::a;
+    using Base::b;
+    using Base::c;
+
+public:
+    typedef StatsPolicy Statistics; ///< Политика статистики (используется CachedRoots)
+    
+    /**
+     * @brief Конструктор по умолчанию
+     * @details Создает полином с коэффициентами a=1, b=1, c=1
+     * @post Учитывает экземпляр согласно политике статистики
+     */
+    constexpr BasicPolynomial()
+        : Base(1, 1, 1) {}
+    
+    /**
+     * @brief Конструктор с одним параметром
+     * @param constant Значение константы c
+     * @details Создает полином с коэффициентами a=0, b=0, c=constant
+     * @post Учитывает экземпляр согласно политике статистики
+     */
+    constexpr BasicPolynomial(Scalar constant)
+        : Base(0, 0, constant) {}
+    
+    /**
+     * @brief Конструктор с тремя параметрами
+     * @param a_val Коэффициент при x²
+     * @param b_val Коэффициент при x
+     * @param c_val Свободный член
+     * @post Учитывает экземпляр согласно политике статистики
+     */
+    constexpr BasicPolynomial(Scalar a_val, Scalar b_val, Scalar c_val) 
+        : Base(a_val, b_val, c_val) {}
+    
+    /**
+     * @brief Конструктор из полинома с другой политикой статистики
+     * @param other Полином той же точности
+     * @post Учитывает экземпляр согласно политике статистики
+     */
+    template <typename OtherPolicy>
+    explicit constexpr BasicPolynomial(const BasicPolynomial<OtherPolicy, Precision>& other)
+        : Base(other.getA(), other.getB(), other.getC()) {}
+    
+    /**
+     * @brief Конструктор из выражения (см. ExpressionTemplates)
+     * @param expression Выражение над полиномами, например expr(p1) + expr(p2) - 3.0 * expr(p3)
+     * @details Коэффициенты вычисляются сразу в создаваемый объект, без
+     * промежуточных полиномов
+     * @post Учитывает один экземпляр согласно политике статистики
+     */
+    template <typename Expression>
+    BasicPolynomial(const PolynomialExpression<Expression>& expression)
+        : Base(expression.self().a(0), expression.self().b(0), expression.self().c(0)) {
+        static_assert(!Expression::elementwise, "Vyrazhenie s massivom zapisyvaetsya cherez assign()");
+    }
+    
+    /**
+     * @brief Присваивает значение выражения
+     * @param expression Выражение над полиномами (может содержать *this)
+     * @return Ссылка на текущий объект
+     */
+    template <typename Expression>
+    BasicPolynomial& operator=(const PolynomialExpression<Expression>& expression) {
+        static_assert(!Expression::elementwise, "Vyrazhenie s massivom zapisyvaetsya cherez assign()");
+        const Expression& e = expression.self();
+        Scalar newA = e.a(0), newB = e.b(0), newC = e.c(0);
+        a = newA;
+        b = newB;
+        c = newC;
+        return *this;
+    }
+    
+    /**
+     * @defgroup StaticMethods Статические методы
+     * @brief Доступ к общей статистике (см. PolynomialStatistics)
+     * @{
+     */
+    
+    /**
+     * @brief Устанавливает флаг завершения программы
+     * @param finished true - программа завершена, false - программа работает
+     */
+    static void setProgramFinished(bool finished) {
+        PolynomialStatistics::setProgramFinished(finished);
+    }
+    
+    /**
+     * @brief Выводит статистику вычисления корней
+     */
+    static void showRootCalculationStats() {
+        PolynomialStatistics::showRootCalculationStats();
+    }
+    
+    /**
+     * @brief Выводит финальную статистику программы
+     */
+    static void printFinalStatistics() {
+        PolynomialStatistics::printFinalStatistics();
+    }
+    
+    /**
+     * @brief Очищает все статические данные статистики
+     * @warning Должен вызываться только при завершении программы
+     */
+    static void cleanupStaticData() {
+        PolynomialStatistics::cleanupStaticData();
+    }
+    
+    /**
+     * @brief Возвращает арену сессии статистики
+     * @see PolynomialStatistics::sessionResource()
+     */
+    static std::pmr::memory_resource* sessionResource() {
+        return PolynomialStatistics::sessionResource();
+    }
+    
+    /**
+     * @brief Возвращает количество вычислений корней
+     * @return Количество вызовов findRoots()
+     */
+    static int getRootCalculationCount() {
+        return PolynomialStatistics::getRootCalculationCount();
+    }
+    
+    /**
+     * @brief Возвращает потоковые агрегаты вычислений корней
+     * @see PolynomialStatistics::getRootAggregate()
+     */
+    static RootAggregate getRootAggregate() {
+        return PolynomialStatistics::getRootAggregate();
+    }
+    
+    /**
+     * @brief Включает или выключает замер задержек операций
+     * @see PolynomialStatistics::setLatencyTracking()
+     */
+    static void setLatencyTracking(bool enabled) {
+        PolynomialStatistics::setLatencyTracking(enabled);
+    }
+    
+    /**
+     * @brief Возвращает количество созданных экземпляров
+     * @return Общее количество созданных полиномов с учетом экземпляров
+     */
+    static int getInstanceCount() {
+        return PolynomialStatistics::getInstanceCount();
+    }
+    
+    /**
+     * @brief Сбрасывает всю статистику
+     * @pre Другие потоки не работают с полиномами со статистикой
+     */
+    static void resetStatistics() {
+        PolynomialStatistics::resetStatistics();
+    }
+    
+    /** @} */ // конец группы StaticMethods
+
+    /**
+     * @brief Вычисляет корни квадратного уравнения без ведения статистики
+     * @param a Коэффициент при x²
+     * @param b Коэффициент при x
+     * @param c Свободный член
+     * @param[out] root1 Первый корень (если существует)
+     * @param[out] root2 Второй корень (если существует)
+     * @param[out] numRoots Количество действительных корней (0, 1 или 2)
+     * @details Чистое вычислительное ядро, общее для findRoots() и пакетных
+     * обходов PolynomialArray. Несуществующие корни не записываются.
+     * Вычисления ведутся в типе Compute (для MixedPrecision - в double).
+     */
+    static constexpr void solveQuadratic(Compute a, Compute b, Compute c,
+                                         Compute& root1, Compute& root2, int& numRoots) {
+        numRoots = 0;
+        
+        if (a == 0) {
+            if (b != 0) {
+                root1 = -c / b;
+                numRoots = 1;
+            }
+        } else {
+            Compute discriminant = b * b - 4 * a * c;
+            
+            if (discriminant > 0) {
+                root1 = (-b + squareRoot(discriminant)) / (2 * a);
+                root2 = (-b - squareRoot(discriminant)) / (2 * a);
+                numRoots = 2;
+            } else if (discriminant == 0) {
+                root1 = -b / (2 * a);
+                numRoots = 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Вычисляет пару корней, включая комплексно-сопряженные
+     * @param a Коэффициент при x²
+     * @param b Коэффициент при x
+     * @param c Свободный член
+     * @return Пара корней (см. ComplexRootPair)
+     * 
+     * @details
+     * Устойчивая форма: q = -(b + sign(b)*sqrt(D))/2, корни q/a и c/q, поэтому
+     * при b² >> 4ac меньший корень не теряет точность из-за вычитания. На
+     * полином один корень sqrt(|D|); действительный и комплексный ответы
+     * вычисляются оба и выбираются по знаку D без ветвлений. Деление на a
+     * заменено умножением на 1/a, поэтому делений всего два: 1/a и c/q.
+     * - D = 0 и b = 0 (тогда c = 0): оба корня q/a = 0
+     * - a = 0: второй корень равен -c/b, первый - бесконечность
+     *   (корень квадратного уравнения, ушедший на бесконечность)
+     */
+    static constexpr ComplexRootPair<Compute> solveQuadraticComplex(Compute a, Compute b, Compute c) {
+        Compute discriminant = b * b - 4 * a * c;
+        bool complex = discriminant < 0;
+        Compute root = squareRoot(complex ? -discriminant : discriminant);
+        Compute q = -(b + (b < 0 ? -root : root)) / 2;
+        Compute inverseA = 1 / a;
+        Compute realFirst = q * inverseA;
+        Compute realSecond = q == 0 ? realFirst : c / q;
+        Compute halfInverseA = inverseA / 2;
+        Compute center = -b * halfInverseA;
+        Compute spread = root * (halfInverseA < 0 ? -halfInverseA : halfInverseA);
+        ComplexRootPair<Compute> result = {
+            complex ? center : realFirst, complex ? spread : 0,
+            complex ? center : realSecond, complex ? -spread : 0
+        };
+        return result;
+    }
+
+    /**
+     * @brief Находит корни квадратного уравнения
+     * @param[out] root1 Первый корень (если существует)
+     * @param[out] root2 Второй корень (если существует)
+     * @param[out] numRoots Количество действительных корней (0, 1 или 2)
+     * @details Вычисляет корни уравнения ax² + bx + c = 0
+     * Обрабатывает случаи:
+     * - a = 0 (линейное уравнение)
+     * - Дискриминант > 0 (два корня)
+     * - Дискриминант = 0 (один корень)
+     * - Дискриминант < 0 (нет действительных корней)
+     * 
+     * Для повторных запросов к неизменному полиному см. CachedRoots.
+     * @post Регистрирует вычисление согласно политике статистики
+     */
+    constexpr void findRoots(Compute& root1, Compute& root2, int& numRoots) {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        solveQuadratic(a, b, c, root1, root2, numRoots);
+        StatsPolicy::onRootCalculation(a, b, c, root1, root2, numRoots);
+        StatsPolicy::onLatency(findRootsLatency, started);
+    }
+    
+    /**
+     * @brief Вычисляет корни без статистики
+     * @return Корни; несуществующие равны NaN
+     * @details Константный вариант findRoots() для константных выражений:
+     * @code
+     * constexpr QuadraticRoots<double> r = PlainPolynomial(1, -3, 2).roots();
+     * @endcode
+     */
+    constexpr QuadraticRoots<Compute> roots() const {
+        QuadraticRoots<Compute> result = {NAN, NAN, 0};
+        solveQuadratic(a, b, c, result.root1, result.root2, result.count);
+        return result;
+    }
+    
+    /**
+     * @brief Находит пару корней, включая комплексно-сопряженные
+     * @return Пара корней (см. solveQuadraticComplex())
+     * @details В отличие от findRoots() отрицательный дискриминант не
+     * означает отсутствия ответа. Не ведет статистику.
+     * Порядок корней может отличаться от findRoots()
+     */
+    constexpr ComplexRootPair<Compute> complexRoots() const {
+        return solveQuadraticComplex(a, b, c);
+    }
+
+    /**
+     * @defgroup UnaryOperators Унарные операторы
+     * @brief Операции инкремента и декремента
+     * @{
+     */
+    
+    /**
+     * @brief Префиксный инкремент
+     * @return Ссылка на измененный полином
+     * @post Увеличивает все коэффициенты на 1
+     */
+    constexpr BasicPolynomial& operator++() {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        ++a; ++b; ++c;
+        StatsPolicy::onLatency(arithmeticLatency, started);
+        return *this;
+    }
+
+    /**
+     * @brief Постфиксный инкремент
+     * @return Копия полинома до изменения
+     * @post Увеличивает все коэффициенты на 1
+     */
+    constexpr BasicPolynomial operator++(int) {
+        BasicPolynomial temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    /**
+     * @brief Префиксный декремент
+     * @return Ссылка на измененный полином
+     * @post Уменьшает все коэффициенты на 1
+     */
+    constexpr BasicPolynomial& operator--() {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        --a; --b; --c;
+        StatsPolicy::onLatency(arithmeticLatency, started);
+        return *this;
+    }
+
+    /**
+     * @brief Постфиксный декремент
+     * @return Копия полинома до изменения
+     * @post Уменьшает все коэффициенты на 1
+     */
+    constexpr BasicPolynomial operator--(int) {
+        BasicPolynomial temp = *this;
+        --(*this);
+        return temp;
+    }
+    
+    /** @} */ // конец группы UnaryOperators
+
+    /**
+     * @defgroup CompoundAssignment Составные операторы присваивания
+     * @brief Операторы вида @c operator@=
+     * @{
+     */
+    
+    /**
+     * @brief Оператор сложения с присваиванием
+     * @param other Полином для сложения
+     * @return Ссылка на текущий объект
+     */
+    constexpr BasicPolynomial& operator+=(const BasicPolynomial& other) {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        a += other.a;
+        b += other.b;
+        c += other.c;
+        StatsPolicy::onLatency(arithmeticLatency, started);
+        return *this;
+    }
+
+    /**
+     * @brief Оператор вычитания с присваиванием
+     * @param other Полином для вычитания
+     * @return Ссылка на текущий объект
+     */
+    constexpr BasicPolynomial& operator-=(const BasicPolynomial& other) {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        a -= other.a;
+        b -= other.b;
+        c -= other.c;
+        StatsPolicy::onLatency(arithmeticLatency, started);
+        return *this;
+    }
+
+    /**
+     * @brief Оператор умножения на скаляр с присваиванием
+     * @param scalar Скаляр для умножения
+     * @return Ссылка на текущий объект
+     */
+    constexpr BasicPolynomial& operator*=(Scalar scalar) {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        a *= scalar;
+        b *= scalar;
+        c *= scalar;
+        StatsPolicy::onLatency(arithmeticLatency, started);
+        return *this;
+    }
+
+    /**
+     * @brief Оператор деления на скаляр с присваиванием
+     * @param scalar Скаляр для деления
+     * @return Ссылка на текущий объект
+     * @throws std::invalid_argument если scalar = 0
+     */
+    constexpr BasicPolynomial& operator/=(Scalar scalar) {
+        if (scalar == 0) {
+            throw std::invalid_argument("Delenie na nol!");
+        }
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        a /= scalar;
+        b /= scalar;
+        c /= scalar;
+        StatsPolicy::onLatency(arithmeticLatency, started);
+        return *this;
+    }
+    
+    /** @} */ // конец группы CompoundAssignment
+
+    /**
+     * @defgroup ArithmeticOperations Арифметические операции
+     * @brief Бинарные арифметические операторы
+     * @{
+     */
+    
+    /**
+     * @brief Сложение двух полиномов
+     * @param lhs Левый операнд
+     * @param rhs Правый операнд
+     * @return Новый полином - сумма lhs и rhs
+     */
+    friend constexpr BasicPolynomial operator+(BasicPolynomial lhs, const BasicPolynomial& rhs) {
+        lhs += rhs;
+        return lhs;
+    }
+
+    /**
+     * @brief Вычитание двух полиномов
+     * @param lhs Левый операнд
+     * @param rhs Правый операнд
+     * @return Новый полином - разность lhs и rhs
+     */
+    friend constexpr BasicPolynomial operator-(BasicPolynomial lhs, const BasicPolynomial& rhs) {
+        lhs -= rhs;
+        return lhs;
+    }
+
+    /**
+     * @brief Умножение полинома на скаляр
+     * @param lhs Полином
+     * @param scalar Скаляр
+     * @return Новый полином - произведение lhs и scalar
+     */
+    friend constexpr BasicPolynomial operator*(BasicPolynomial lhs, Scalar scalar) {
+        lhs *= scalar;
+        return lhs;
+    }
+
+    /**
+     * @brief Умножение скаляра на полином
+     * @param scalar Скаляр
+     * @param rhs Полином
+     * @return Новый полином - произведение scalar и rhs
+     */
+    friend constexpr BasicPolynomial operator*(Scalar scalar, const BasicPolynomial& rhs) {
+        BasicPolynomial result = rhs;
+        result *= scalar;
+        return result;
+    }
+
+    /**
+     * @brief Деление полинома на скаляр
+     * @param lhs Полином
+     * @param scalar Скаляр
+     * @return Новый полином - частное lhs и scalar
+     * @throws std::invalid_argument если scalar = 0
+     */
+    friend constexpr BasicPolynomial operator/(BasicPolynomial lhs, Scalar scalar) {
+        lhs /= scalar;
+        return lhs;
+    }
+    
+    /** @} */ // конец группы ArithmeticOperations
+
+    /**
+     * @defgroup ComparisonOperations Операции сравнения
+     * @brief Операторы сравнения полиномов
+     * @details Все операторы сравнения работают на основе значения полинома в точке x=2
+     * @{
+     */
+    
+    /**
+     * @brief Оператор "меньше"
+     * @details Сравнивает значения полиномов в точке x=2
+     */
+    friend constexpr bool operator<(const BasicPolynomial& lhs, const BasicPolynomial& rhs) {
+        return lhs.evaluate(2) < rhs.evaluate(2);
+    }
+
+    /**
+     * @brief Оператор "больше"
+     * @details Сравнивает значения полиномов в точке x=2
+     */
+    friend constexpr bool operator>(const BasicPolynomial& lhs, const BasicPolynomial& rhs) {
+        return lhs.evaluate(2) > rhs.evaluate(2);
+    }
+
+    /**
+     * @brief Оператор "меньше или равно"
+     * @details Сравнивает значения полиномов в точке x=2
+     */
+    friend constexpr bool operator<=(const BasicPolynomial& lhs, const BasicPolynomial& rhs) {
+        return lhs.evaluate(2) <= rhs.evaluate(2);
+    }
+
+    /**
+     * @brief Оператор "больше или равно"
+     * @details Сравнивает значения полиномов в точке x=2
+     */
+    friend constexpr bool operator>=(const BasicPolynomial& lhs, const BasicPolynomial& rhs) {
+        return lhs.evaluate(2) >= rhs.evaluate(2);
+    }
+
+    /**
+     * @brief Оператор равенства
+     * @details Сравнивает значения полиномов в точке x=2
+     */
+    friend constexpr bool operator==(const BasicPolynomial& lhs, const BasicPolynomial& rhs) {
+        return lhs.evaluate(2) == rhs.evaluate(2);
+    }
+
+    /**
+     * @brief Оператор неравенства
+     * @details Сравнивает значения полиномов в точке x=2
+     */
+    friend constexpr bool operator!=(const BasicPolynomial& lhs, const BasicPolynomial& rhs) {
+        return lhs.evaluate(2) != rhs.evaluate(2);
+    }
+    
+    /**
+     * @brief Возвращает ключ, по которому работают операторы сравнения
+     * @return Значение полинома в точке x=2
+     */
+    constexpr Compute comparisonKey() const {
+        return evaluate(2);
+    }
+    
+    /** @} */ // конец группы ComparisonOperations
+
+    /**
+     * @brief Вычисляет значение полинома в заданной точке
+     * @param x Точка для вычисления
+     * @return Значение полинома в точке x: a*x² + b*x + c
+     */
+    constexpr Compute evaluate(Compute x) const {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        Compute value = Compute(a) * x * x + Compute(b) * x + Compute(c);
+        StatsPolicy::onLatency(evaluateLatency, started);
+        return value;
+    }
+    
+    /**
+     * @brief Вычисляет значения полинома в массиве точек
+     * @param x Точки для вычисления
+     * @param n Количество точек
+     * @param[out] out Значения полинома, out[i] = p(x[i])
+     * @note Вычисление по схеме Горнера (см. evaluatePointsBatch()),
+     * результат может отличаться от evaluate() в последнем разряде
+     */
+    void evaluateMany(const Compute* x, std::size_t n, Compute* out) const {
+        evaluatePointsBatch(Compute(a), Compute(b), Compute(c), x, n, out);
+    }
+
+    /**
+     * @brief Выводит полином в читаемом формате
+     * @details Формат вывода: "ax^2 + bx + c"
+     * Пример: "3.5x^2 + -2x + 1"
+     */
+    void print() const {
+        std::cout << a << "x^2 + " << b << "x + " << c;
+    }
+
+    /**
+     * @defgroup GetterMethods Геттеры
+     * @brief Методы для получения значений коэффициентов
+     * @{
+     */
+    
+    /**
+     * @brief Возвращает коэффициент a
+     * @return Коэффициент при x²
+     */
+    constexpr Scalar getA() const { return a; }
+    
+    /**
+     * @brief Возвращает коэффициент b
+     * @return Коэффициент при x
+     */
+    constexpr Scalar getB() const { return b; }
+    
+    /**
+     * @brief Возвращает коэффициент c
+     * @return Свободный член
+     */
+    constexpr Scalar getC() const { return c; }
+    
+    /** @} */ // конец группы GetterMethods
+};
+
+/**
+ * @typedef Polynomial
+ * @brief Полином с полной статистикой (поведение по умолчанию)
+ */
+typedef BasicPolynomial<FullStatistics> Polynomial;
+
+/**
+ * @typedef PolynomialView
+ * @brief Представление элемента PolynomialArray (см. ViewStatistics)
+ */
+typedef BasicPolynomial<ViewStatistics> PolynomialView;
+
+/**
+ * @typedef CountedPolynomial
+ * @brief Полином, ведущий только счетчики
+ */
+typedef BasicPolynomial<CountingStatistics> CountedPolynomial;
+
+/**
+ * @typedef PlainPolynomial
+ * @brief Полином без статистики: тривиально копируемый и разрушаемый
+ */
+typedef BasicPolynomial<NoStatistics> PlainPolynomial;
+
+/**
+ * @typedef FloatPolynomial
+ * @brief Полином без статистики с коэффициентами и вычислениями во float
+ */
+typedef BasicPolynomial<NoStatistics, float> FloatPolynomial;
+
+/**
+ * @typedef LongDoublePolynomial
+ * @brief Полином без статистики в long double (для проверки точности)
+ */
+typedef BasicPolynomial<NoStatistics, long double> LongDoublePolynomial;
+
+/**
+ * @typedef MixedPolynomial
+ * @brief Полином без статистики: коэффициенты во float, дискриминант в double
+ */
+typedef BasicPolynomial<NoStatistics, MixedPrecision> MixedPolynomial;
+
+static_assert(std::is_trivially_copyable<PlainPolynomial>::value,
+              "PlainPolynomial must be trivially copyable");
+static_assert(std::is_trivially_destructible<PlainPolynomial>::value,
+              "PlainPolynomial must be trivially destructible");
+static_assert(PlainPolynomial(1, -3, 2).evaluate(2) == 0,
+              "PlainPolynomial::evaluate must be usable at compile time");
+static_assert(PlainPolynomial(1, -3, 2).roots().count == 2 && PlainPolynomial(1, -3, 2).roots().root1 == 2,
+              "PlainPolynomial::roots must be usable at compile time");
+static_assert(sizeof(PlainPolynomial) == 3 * sizeof(double),
+              "PlainPolynomial must hold only its coefficients");
+
+/**
+ * @class CachedRoots
+ * @brief Полином с запоминанием результата findRoots()
+ * @tparam Poly Вариант BasicPolynomial
+ * 
+ * @details
+ * Кэш вынесен из BasicPolynomial, чтобы обычные полиномы оставались тремя
+ * коэффициентами, а их операторы - чистой арифметикой. Обертка нужна там,
+ * где один и тот же полином многократно опрашивается между изменениями.
+ * 
+ * Кэш сбрасывают ++, --, += и -=. *= и /= сохраняют его, если
+ * масштабированные коэффициенты конечны, нулевые коэффициенты остались
+ * нулевыми (иначе меняется вид уравнения) и знак дискриминанта не изменился
+ * от округления (иначе меняется число корней). После масштабирования
+ * возвращаются корни исходного полинома: их число совпадает с заново
+ * вычисленным, а значения могут отличаться в последнем разряде.
+ */
+template <typename Poly>
+class CachedRoots {
+public:
+    typedef typename Poly::Scalar Scalar;   ///< Тип коэффициентов
+    typedef typename Poly::Compute Compute; ///< Тип корней
+    
+    /**
+     * @brief Конструктор
+     * @param p Исходный полином
+     */
+    explicit constexpr CachedRoots(const Poly& p)
+        : poly(p), cachedRoot1(NAN), cachedRoot2(NAN), cachedNumRoots(0), rootsValid(false) {}
+    
+    /**
+     * @brief Возвращает обернутый полином
+     */
+    constexpr const Poly& polynomial() const {
+        return poly;
+    }
+    
+    /**
+     * @brief Находит корни, решая уравнение только после изменения коэффициентов
+     * @param[out] root1 Первый корень (если существует)
+     * @param[out] root2 Второй корень (если существует)
+     * @param[out] numRoots Количество действительных корней
+     * @post Учитывает обращение к кэшу согласно политике статистики полинома;
+     * как и в RootCache, вычислением корней считается только промах
+     */
+    constexpr void findRoots(Compute& root1, Compute& root2, int& numRoots) {
+        Poly::Statistics::onRootCacheLookup(rootsValid);
+        if (!rootsValid) {
+            poly.findRoots(cachedRoot1, cachedRoot2, cachedNumRoots);
+            rootsValid = true;
+        }
+        numRoots = cachedNumRoots;
+        if (numRoots >= 1) {
+            root1 = cachedRoot1;
+        }
+        if (numRoots >= 2) {
+            root2 = cachedRoot2;
+        }
+    }
+    
+    /**
+     * @brief Проверяет, есть ли актуальный результат findRoots()
+     * @return true, если следующий findRoots() не будет решать уравнение
+     */
+    constexpr bool hasCachedRoots() const {
+        return rootsValid;
+    }
+    
+    constexpr CachedRoots& operator++() {
+        ++poly;
+        rootsValid = false;
+        return *this;
+    }
+    
+    constexpr CachedRoots& operator--() {
+        --poly;
+        rootsValid = false;
+        return *this;
+    }
+    
+    constexpr CachedRoots& operator+=(const Poly& other) {
+        poly += other;
+        rootsValid = false;
+        return *this;
+    }
+    
+    constexpr CachedRoots& operator-=(const Poly& other) {
+        poly -= other;
+        rootsValid = false;
+        return *this;
+    }
+    
+    constexpr CachedRoots& operator*=(Scalar scalar) {
+        const Scalar oldA = poly.getA(), oldB = poly.getB(), oldC = poly.getC();
+        poly *= scalar;
+        rescaleRoots(oldA, oldB, oldC);
+        return *this;
+    }
+    
+    /**
+     * @throws std::invalid_argument если scalar = 0 (кэш не меняется)
+     */
+    constexpr CachedRoots& operator/=(Scalar scalar) {
+        const Scalar oldA = poly.getA(), oldB = poly.getB(), oldC = poly.getC();
+        poly /= scalar;
+        rescaleRoots(oldA, oldB, oldC);
+        return *this;
+    }
+
+private:
+    Poly poly;              ///< Обернутый полином
+    Compute cachedRoot1;    ///< Первый корень последнего вычисления
+    Compute cachedRoot2;    ///< Второй корень последнего вычисления
+    int cachedNumRoots;     ///< Количество корней последнего вычисления
+    bool rootsValid;        ///< Кэш соответствует текущим коэффициентам
+    
+    /**
+     * @brief Сохраняет кэш после масштабирования коэффициентов
+     * @param oldA Коэффициент при x² до масштабирования
+     * @param oldB Коэффициент при x до масштабирования
+     * @param oldC Свободный член до масштабирования
+     * @details Корни p и s*p совпадают, поэтому кэш остается актуальным, если
+     * новые коэффициенты конечны, нулевые коэффициенты остались нулевыми и
+     * дискриминант, посчитанный как в solveQuadratic(), дает прежнее число
+     * корней (при D, близком к нулю, округление s*a, s*b, s*c меняет его знак)
+     */
+    constexpr void rescaleRoots(Scalar oldA, Scalar oldB, Scalar oldC) {
+        Scalar a = poly.getA(), b = poly.getB(), c = poly.getC();
+        rootsValid = rootsValid &&
+            isFiniteValue(a) && isFiniteValue(b) && isFiniteValue(c) &&
+            (oldA == 0) == (a == 0) && (oldB == 0) == (b == 0) && (oldC == 0) == (c == 0);
+        if (rootsValid && a != 0) {
+            Compute discriminant = Compute(b) * Compute(b) - 4 * Compute(a) * Compute(c);
+            int numRoots = discriminant > 0 ? 2 : (discriminant == 0 ? 1 : 0);
+            rootsValid = numRoots == cachedNumRoots;
+        }
+    }
+};
+
+/** @} */ // конец группы PolynomialClass
+
+// Инициализация статических членов класса PolynomialStatistics
+StatisticsShard* PolynomialStatistics::shards = nullptr;
+std::mutex PolynomialStatistics::registryMutex;
+thread_local StatisticsShard* PolynomialStatistics::currentShard = nullptr;
+thread_local bool PolynomialStatistics::leaseReleased = false;
+StatisticsShard* PolynomialStatistics::exitShard = nullptr;
+std::mutex PolynomialStatistics::exitShardMutex;
+
+std::atomic<std::uint64_t> PolynomialStatistics::rootSequence(0);
+std::atomic<std::uint64_t> PolynomialStatistics::deletionSequence(0);
+
+std::pmr::synchronized_pool_resource PolynomialStatistics::sessionArena;
+
+/**
+ * @brief Читает начальное состояние замера задержек из POLY_LATENCY
+ * @return true, если переменная задана и не равна "0"
+ */
+bool latencyTrackingRequested() {
+    const char* requested = std::getenv("POLY_LATENCY");
+    return requested != nullptr && *requested != '\0' && std::strcmp(requested, "0") != 0;
+}
+
+std::atomic<bool> PolynomialStatistics::latencyTracking(latencyTrackingRequested());
+const std::uint64_t PolynomialStatistics::epochTimestamp = latencyTimestamp();
+const std::chrono::steady_clock::time_point PolynomialStatistics::epochTime =
+    std::chrono::steady_clock::now();
+
+/**
+ * @brief Читает начальное состояние аппаратных счетчиков из POLY_PERF
+ * @return true, если переменная задана и не равна "0"
+ */
+bool perfCountersRequested() {
+    const char* requested = std::getenv("POLY_PERF");
+    return requested != nullptr && *requested != '\0' && std::strcmp(requested, "0") != 0;
+}
+
+std::atomic<bool> PolynomialStatistics::perfCounting(perfCountersRequested());
+std::atomic<unsigned> PolynomialStatistics::perfAvailableMask(0);
+std::atomic<int> PolynomialStatistics::perfOpenError(0);
+
+// По умолчанию каждый поток хранит последние 1024 записи каждой истории без прореживания
+std::size_t PolynomialStatistics::rootRetention = 1024;
+std::size_t PolynomialStatistics::rootSampleEvery = 1;
+std::size_t PolynomialStatistics::deletedRetention = 1024;
+std::size_t PolynomialStatistics::deletedSampleEvery = 1;
+
+std::atomic<bool> PolynomialStatistics::programFinished(false);
+
+/**
+ * @defgroup BatchKernels Пакетные вычислительные ядра
+ * @brief Функции, обрабатывающие целые массивы коэффициентов
+ * 
+ * @details
+ * Векторные части ядер компилируются в нескольких вариантах (AVX2+FMA и
+ * AVX-512) независимо от флагов сборки, а вариант выбирается один раз при
+ * запуске по CPUID (см. activeKernelIsa). Поэтому один исполняемый файл
+ * работает и на процессорах только с SSE4.2, и использует AVX-512 там, где
+ * он есть.
+ * @{
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define POLY_KERNEL_DISPATCH 1
+#define POLY_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define POLY_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+// Ядра корней должны совпадать со скалярным solveQuadratic() побитово, а GCC
+// по умолчанию (-ffp-contract=fast) слил бы b*b - 4*a*c в FMA, доступную в
+// этих вариантах. Clang не сливает операции из разных встроенных функций.
+#if defined(__clang__)
+#define POLY_NO_FP_CONTRACT
+#else
+#define POLY_NO_FP_CONTRACT __attribute__((optimize("fp-contract=off")))
+#endif
+#endif
+
+/**
+ * @enum KernelIsa
+ * @brief Набор инструкций для векторных частей ядер
+ */
+enum class KernelIsa {
+    scalar, ///< Без векторных вариантов (SSE2/SSE4.2 или не x86)
+    avx2,   ///< AVX2 и FMA
+    avx512  ///< AVX-512F
+};
+
+/**
+ * @brief Возвращает название набора инструкций
+ * @param isa Набор инструкций
+ * @return "scalar", "avx2" или "avx512" (как в переменной POLY_ISA)
+ */
+const char* kernelIsaName(KernelIsa isa) {
+    switch (isa) {
+    case KernelIsa::avx512:
+        return "avx512";
+    case KernelIsa::avx2:
+        return "avx2";
+    case KernelIsa::scalar:
+        break;
+    }
+    return "scalar";
+}
+
+/**
+ * @brief Определяет лучший набор инструкций, поддерживаемый процессором и ОС
+ * @return Набор инструкций по данным CPUID
+ */
+KernelIsa detectKernelIsa() {
+#if defined(POLY_KERNEL_DISPATCH)
+    // Вызывается при статической инициализации, до конструкторов libgcc
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return KernelIsa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return KernelIsa::avx2;
+    }
+#endif
+    return KernelIsa::scalar;
+}
+
+/**
+ * @brief Выбирает набор инструкций с учетом переменной окружения POLY_ISA
+ * @return Набор инструкций для ядер
+ * @details POLY_ISA=scalar|avx2|avx512 принудительно выбирает вариант (для
+ * сравнительных замеров), auto или пустое значение - выбор по CPUID.
+ * Вариант, не поддерживаемый процессором, не включается: вместо него
+ * берется лучший доступный, с предупреждением в stderr.
+ */
+KernelIsa selectKernelIsa() {
+    KernelIsa detected = detectKernelIsa();
+    const char* requested = std::getenv("POLY_ISA");
+    if (requested == nullptr || requested[0] == '\0' || std::strcmp(requested, "auto") == 0) {
+        return detected;
+    }
+    
+    const KernelIsa known[] = {KernelIsa::scalar, KernelIsa::avx2, KernelIsa::avx512};
+    for (KernelIsa isa : known) {
+        if (std::strcmp(requested, kernelIsaName(isa)) == 0) {
+            if (isa > detected) {
+                std::fprintf(stderr, "POLY_ISA=%s ne podderzhivaetsya processorom, ispolzuetsya %s\n",
+                             requested, kernelIsaName(detected));
+                return detected;
+            }
+            return isa;
+        }
+    }
+    std::fprintf(stderr, "Neizvestnoe znachenie POLY_ISA=%s, ispolzuetsya %s\n",
+                 requested, kernelIsaName(detected));
+    return detected;
+}
+
+/**
+ * @brief Набор инструкций, выбранный при запуске программы
+ */
+const KernelIsa activeKernelIsa = selectKernelIsa();
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть solveRootsBatch() для AVX-512
+ * @return Количество обработанных элементов
+ */
+POLY_TARGET_AVX512 POLY_NO_FP_CONTRACT
+std::size_t solveRootsBatchAvx512(const double* a, const double* b, const double* c, std::size_t n,
+                     double* root1, double* root2, int* numRoots) {
+    std::size_t i = 0;
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d two = _mm512_set1_pd(2.0);
+    const __m512d four = _mm512_set1_pd(4.0);
+    const __m512d minusOne = _mm512_set1_pd(-1.0);
+    const __m512d nan = _mm512_set1_pd(NAN);
+    
+    for (; i + 8 <= n; i += 8) {
+        __m512d va = _mm512_loadu_pd(a + i);
+        __m512d vb = _mm512_loadu_pd(b + i);
+        __m512d vc = _mm512_loadu_pd(c + i);
+        
+        __m512d negB = _mm512_mul_pd(minusOne, vb);
+        __m512d negC = _mm512_mul_pd(minusOne, vc);
+        __m512d twoA = _mm512_mul_pd(two, va);
+        __m512d disc = _mm512_sub_pd(_mm512_mul_pd(vb, vb), _mm512_mul_pd(_mm512_mul_pd(four, va), vc));
+        __m512d sq = _mm512_sqrt_pd(disc);
+        
+        __mmask8 aZero = _mm512_cmp_pd_mask(va, zero, _CMP_EQ_OQ);
+        __mmask8 bNonZero = _mm512_cmp_pd_mask(vb, zero, _CMP_NEQ_UQ);
+        __mmask8 linear = aZero & bNonZero;
+        __mmask8 twoRoots = _mm512_cmp_pd_mask(disc, zero, _CMP_GT_OQ) & ~aZero;
+        __mmask8 oneRoot = _mm512_cmp_pd_mask(disc, zero, _CMP_EQ_OQ) & ~aZero;
+        
+        // Числители и знаменатели выбираются до деления, чтобы делить
+        // один раз на корень, а не в каждой ветви
+        __m512d numerator = _mm512_mask_blend_pd(twoRoots, negB, _mm512_add_pd(negB, sq));
+        numerator = _mm512_mask_blend_pd(linear, numerator, negC);
+        __m512d denominator = _mm512_mask_blend_pd(linear, twoA, vb);
+        __mmask8 hasRoot1 = twoRoots | oneRoot | linear;
+        __m512d r1 = _mm512_mask_blend_pd(hasRoot1, nan, _mm512_div_pd(numerator, denominator));
+        __m512d r2 = _mm512_mask_blend_pd(twoRoots, nan, _mm512_div_pd(_mm512_sub_pd(negB, sq), twoA));
+        
+        __m512d cnt = _mm512_mask_blend_pd(twoRoots, zero, two);
+        cnt = _mm512_mask_blend_pd(oneRoot | linear, cnt, one);
+        
+        _mm512_storeu_pd(root1 + i, r1);
+        _mm512_storeu_pd(root2 + i, r2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(numRoots + i), _mm512_cvtpd_epi32(cnt));
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть solveRootsBatch() для AVX2 и FMA
+ * @return Количество обработанных элементов
+ */
+POLY_TARGET_AVX2 POLY_NO_FP_CONTRACT
+std::size_t solveRootsBatchAvx2(const double* a, const double* b, const double* c, std::size_t n,
+                     double* root1, double* root2, int* numRoots) {
+    std::size_t i = 0;
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m256d four = _mm256_set1_pd(4.0);
+    const __m256d minusOne = _mm256_set1_pd(-1.0);
+    const __m256d nan = _mm256_set1_pd(NAN);
+    
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d vb = _mm256_loadu_pd(b + i);
+        __m256d vc = _mm256_loadu_pd(c + i);
+        
+        __m256d negB = _mm256_mul_pd(minusOne, vb);
+        __m256d negC = _mm256_mul_pd(minusOne, vc);
+        __m256d twoA = _mm256_mul_pd(two, va);
+        __m256d disc = _mm256_sub_pd(_mm256_mul_pd(vb, vb), _mm256_mul_pd(_mm256_mul_pd(four, va), vc));
+        __m256d sq = _mm256_sqrt_pd(disc);
+        
+        __m256d aZero = _mm256_cmp_pd(va, zero, _CMP_EQ_OQ);
+        __m256d bNonZero = _mm256_cmp_pd(vb, zero, _CMP_NEQ_UQ);
+        __m256d linear = _mm256_and_pd(aZero, bNonZero);
+        __m256d twoRoots = _mm256_andnot_pd(aZero, _mm256_cmp_pd(disc, zero, _CMP_GT_OQ));
+        __m256d oneRoot = _mm256_andnot_pd(aZero, _mm256_cmp_pd(disc, zero, _CMP_EQ_OQ));
+        
+        // Числители и знаменатели выбираются до деления, чтобы делить
+        // один раз на корень, а не в каждой ветви
+        __m256d numerator = _mm256_blendv_pd(negB, _mm256_add_pd(negB, sq), twoRoots);
+        numerator = _mm256_blendv_pd(numerator, negC, linear);
+        __m256d denominator = _mm256_blendv_pd(twoA, vb, linear);
+        __m256d hasRoot1 = _mm256_or_pd(_mm256_or_pd(twoRoots, oneRoot), linear);
+        __m256d r1 = _mm256_blendv_pd(nan, _mm256_div_pd(numerator, denominator), hasRoot1);
+        __m256d r2 = _mm256_blendv_pd(nan, _mm256_div_pd(_mm256_sub_pd(negB, sq), twoA), twoRoots);
+        
+        __m256d cnt = _mm256_blendv_pd(zero, two, twoRoots);
+        cnt = _mm256_blendv_pd(cnt, one, _mm256_or_pd(oneRoot, linear));
+        
+        _mm256_storeu_pd(root1 + i, r1);
+        _mm256_storeu_pd(root2 + i, r2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(numRoots + i), _mm256_cvtpd_epi32(cnt));
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Находит корни для массивов коэффициентов
+ * @param a Коэффициенты при x²
+ * @param b Коэффициенты при x
+ * @param c Свободные члены
+ * @param n Количество полиномов
+ * @param[out] root1 Первые корни (NaN, если корня нет)
+ * @param[out] root2 Вторые корни (NaN, если корня нет)
+ * @param[out] numRoots Количества действительных корней (0, 1 или 2)
+ * 
+ * @details
+ * Результаты совпадают с Polynomial::solveQuadratic() для каждого элемента.
+ * На процессорах с AVX-512 или AVX2 все ветви (линейное уравнение, константа,
+ * два корня, один корень, нет корней) вычисляются для всего вектора сразу,
+ * а нужный результат выбирается масками, поэтому смешанные входные данные
+ * обрабатываются на полной ширине вектора. Остаток массива и процессоры без
+ * AVX2 обрабатываются скалярным ядром.
+ * @note Векторные части собираются без слияния операций в FMA, поэтому
+ * совпадение со скалярным кодом побитовое при обычных флагах сборки. Если
+ * FMA включена для всей программы (например, -march=native), скалярный код
+ * нужно собирать с -ffp-contract=off. Проверка: --selfcheck
+ * @warning Не ведет статистику вычислений
+ */
+void solveRootsBatch(const double* a, const double* b, const double* c, std::size_t n,
+                     double* root1, double* root2, int* numRoots) {
+    std::size_t i = 0;
+    
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = solveRootsBatchAvx512(a, b, c, n, root1, root2, numRoots);
+        break;
+    case KernelIsa::avx2:
+        i = solveRootsBatchAvx2(a, b, c, n, root1, root2, numRoots);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    
+    for (; i < n; i++) {
+        double r1 = NAN;
+        double r2 = NAN;
+        Polynomial::solveQuadratic(a[i], b[i], c[i], r1, r2, numRoots[i]);
+        root1[i] = r1;
+        root2[i] = r2;
+    }
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть solveRootsBatch() для AVX-512
+ * @return Количество обработанных элементов
+ */
+POLY_TARGET_AVX512 POLY_NO_FP_CONTRACT
+std::size_t solveRootsBatchAvx512(const float* a, const float* b, const float* c, std::size_t n,
+                     float* root1, float* root2, int* numRoots) {
+    std::size_t i = 0;
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 two = _mm512_set1_ps(2.0f);
+    const __m512 four = _mm512_set1_ps(4.0f);
+    const __m512 minusOne = _mm512_set1_ps(-1.0f);
+    const __m512 nan = _mm512_set1_ps(NAN);
+    
+    for (; i + 16 <= n; i += 16) {
+        __m512 va = _mm512_loadu_ps(a + i);
+        __m512 vb = _mm512_loadu_ps(b + i);
+        __m512 vc = _mm512_loadu_ps(c + i);
+        
+        __m512 negB = _mm512_mul_ps(minusOne, vb);
+        __m512 negC = _mm512_mul_ps(minusOne, vc);
+        __m512 twoA = _mm512_mul_ps(two, va);
+        __m512 disc = _mm512_sub_ps(_mm512_mul_ps(vb, vb), _mm512_mul_ps(_mm512_mul_ps(four, va), vc));
+        __m512 sq = _mm512_sqrt_ps(disc);
+        
+        __mmask16 aZero = _mm512_cmp_ps_mask(va, zero, _CMP_EQ_OQ);
+        __mmask16 bNonZero = _mm512_cmp_ps_mask(vb, zero, _CMP_NEQ_UQ);
+        __mmask16 linear = aZero & bNonZero;
+        __mmask16 twoRoots = _mm512_cmp_ps_mask(disc, zero, _CMP_GT_OQ) & ~aZero;
+        __mmask16 oneRoot = _mm512_cmp_ps_mask(disc, zero, _CMP_EQ_OQ) & ~aZero;
+        
+        // Числители и знаменатели выбираются до деления, чтобы делить
+        // один раз на корень, а не в каждой ветви
+        __m512 numerator = _mm512_mask_blend_ps(twoRoots, negB, _mm512_add_ps(negB, sq));
+        numerator = _mm512_mask_blend_ps(linear, numerator, negC);
+        __m512 denominator = _mm512_mask_blend_ps(linear, twoA, vb);
+        __mmask16 hasRoot1 = twoRoots | oneRoot | linear;
+        __m512 r1 = _mm512_mask_blend_ps(hasRoot1, nan, _mm512_div_ps(numerator, denominator));
+        __m512 r2 = _mm512_mask_blend_ps(twoRoots, nan, _mm512_div_ps(_mm512_sub_ps(negB, sq), twoA));
+        
+        __m512 cnt = _mm512_mask_blend_ps(twoRoots, zero, two);
+        cnt = _mm512_mask_blend_ps(oneRoot | linear, cnt, one);
+        
+        _mm512_storeu_ps(root1 + i, r1);
+        _mm512_storeu_ps(root2 + i, r2);
+        _mm512_storeu_si512(numRoots + i, _mm512_cvtps_epi32(cnt));
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть solveRootsBatch() для AVX2 и FMA
+ * @return Количество обработанных элементов
+ */
+POLY_TARGET_AVX2 POLY_NO_FP_CONTRACT
+std::size_t solveRootsBatchAvx2(const float* a, const float* b, const float* c, std::size_t n,
+                     float* root1, float* root2, int* numRoots) {
+    std::size_t i = 0;
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 four = _mm256_set1_ps(4.0f);
+    const __m256 minusOne = _mm256_set1_ps(-1.0f);
+    const __m256 nan = _mm256_set1_ps(NAN);
+    
+    for (; i + 8 <= n; i += 8) {
+        __m256 va = _mm256_loadu_ps(a + i);
+        __m256 vb = _mm256_loadu_ps(b + i);
+        __m256 vc = _mm256_loadu_ps(c + i);
+        
+        __m256 negB = _mm256_mul_ps(minusOne, vb);
+        __m256 negC = _mm256_mul_ps(minusOne, vc);
+        __m256 twoA = _mm256_mul_ps(two, va);
+        __m256 disc = _mm256_sub_ps(_mm256_mul_ps(vb, vb), _mm256_mul_ps(_mm256_mul_ps(four, va), vc));
+        __m256 sq = _mm256_sqrt_ps(disc);
+        
+        __m256 aZero = _mm256_cmp_ps(va, zero, _CMP_EQ_OQ);
+        __m256 bNonZero = _mm256_cmp_ps(vb, zero, _CMP_NEQ_UQ);
+        __m256 linear = _mm256_and_ps(aZero, bNonZero);
+        __m256 twoRoots = _mm256_andnot_ps(aZero, _mm256_cmp_ps(disc, zero, _CMP_GT_OQ));
+        __m256 oneRoot = _mm256_andnot_ps(aZero, _mm256_cmp_ps(disc, zero, _CMP_EQ_OQ));
+        
+        // Числители и знаменатели выбираются до деления, чтобы делить
+        // один раз на корень, а не в каждой ветви
+        __m256 numerator = _mm256_blendv_ps(negB, _mm256_add_ps(negB, sq), twoRoots);
+        numerator = _mm256_blendv_ps(numerator, negC, linear);
+        __m256 denominator = _mm256_blendv_ps(twoA, vb, linear);
+        __m256 hasRoot1 = _mm256_or_ps(_mm256_or_ps(twoRoots, oneRoot), linear);
+        __m256 r1 = _mm256_blendv_ps(nan, _mm256_div_ps(numerator, denominator), hasRoot1);
+        __m256 r2 = _mm256_blendv_ps(nan, _mm256_div_ps(_mm256_sub_ps(negB, sq), twoA), twoRoots);
+        
+        __m256 cnt = _mm256_blendv_ps(zero, two, twoRoots);
+        cnt = _mm256_blendv_ps(cnt, one, _mm256_or_ps(oneRoot, linear));
+        
+        _mm256_storeu_ps(root1 + i, r1);
+        _mm256_storeu_ps(root2 + i, r2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(numRoots + i), _mm256_cvtps_epi32(cnt));
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Находит корни для массивов коэффициентов во float
+ * @details Тот же алгоритм, что и у варианта для double, но вектор вмещает
+ * вдвое больше элементов (16 для AVX-512, 8 для AVX2). Результаты совпадают
+ * с FloatPolynomial::solveQuadratic().
+ * @warning Не ведет статистику вычислений
+ */
+void solveRootsBatch(const float* a, const float* b, const float* c, std::size_t n,
+                     float* root1, float* root2, int* numRoots) {
+    std::size_t i = 0;
+    
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = solveRootsBatchAvx512(a, b, c, n, root1, root2, numRoots);
+        break;
+    case KernelIsa::avx2:
+        i = solveRootsBatchAvx2(a, b, c, n, root1, root2, numRoots);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    
+    for (; i < n; i++) {
+        float r1 = NAN;
+        float r2 = NAN;
+        FloatPolynomial::solveQuadratic(a[i], b[i], c[i], r1, r2, numRoots[i]);
+        root1[i] = r1;
+        root2[i] = r2;
+    }
+}
+
+/**
+ * @brief Находит корни для массивов коэффициентов в long double
+ * @details Векторного варианта нет: long double обрабатывается x87, поэтому
+ * ядро скалярное и служит эталоном при проверке точности
+ * @warning Не ведет статистику вычислений
+ */
+void solveRootsBatch(const long double* a, const long double* b, const long double* c, std::size_t n,
+                     long double* root1, long double* root2, int* numRoots) {
+    for (std::size_t i = 0; i < n; i++) {
+        long double r1 = NAN;
+        long double r2 = NAN;
+        LongDoublePolynomial::solveQuadratic(a[i], b[i], c[i], r1, r2, numRoots[i]);
+        root1[i] = r1;
+        root2[i] = r2;
+    }
+}
+
+/**
+ * @brief Находит корни для коэффициентов во float с вычислениями в double
+ * @details Смешанная точность (см. MixedPrecision): блоки коэффициентов
+ * расширяются до double в буферах на стеке и решаются ядром для double.
+ * Из памяти читается вдвое меньше данных, а дискриминант считается в double.
+ * @warning Не ведет статистику вычислений
+ */
+void solveRootsBatch(const float* a, const float* b, const float* c, std::size_t n,
+                     double* root1, double* root2, int* numRoots) {
+    const std::size_t blockSize = 256;
+    double wideA[blockSize], wideB[blockSize], wideC[blockSize];
+    for (std::size_t begin = 0; begin < n; begin += blockSize) {
+        std::size_t count = n - begin < blockSize ? n - begin : blockSize;
+        if (count == blockSize) {
+            // Постоянное число итераций позволяет компилятору векторизовать расширение
+            for (std::size_t i = 0; i < blockSize; i++) {
+                wideA[i] = a[begin + i];
+                wideB[i] = b[begin + i];
+                wideC[i] = c[begin + i];
+            }
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                wideA[i] = a[begin + i];
+                wideB[i] = b[begin + i];
+                wideC[i] = c[begin + i];
+            }
+        }
+        solveRootsBatch(wideA, wideB, wideC, count, root1 + begin, root2 + begin, numRoots + begin);
+    }
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть solveComplexRootsBatch() для AVX-512
+ * @return Количество обработанных элементов
+ */
+POLY_TARGET_AVX512 POLY_NO_FP_CONTRACT
+std::size_t solveComplexRootsBatchAvx512(const double* a, const double* b, const double* c, std::size_t n,
+                            double* real1, double* imag1, double* real2, double* imag2) {
+    std::size_t i = 0;
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d half = _mm512_set1_pd(0.5);
+    const __m512d four = _mm512_set1_pd(4.0);
+    const __m512d minusOne = _mm512_set1_pd(-1.0);
+    const __m512d minusHalf = _mm512_set1_pd(-0.5);
+    
+    for (; i + 8 <= n; i += 8) {
+        __m512d va = _mm512_loadu_pd(a + i);
+        __m512d vb = _mm512_loadu_pd(b + i);
+        __m512d vc = _mm512_loadu_pd(c + i);
+        
+        __m512d disc = _mm512_sub_pd(_mm512_mul_pd(vb, vb), _mm512_mul_pd(_mm512_mul_pd(four, va), vc));
+        __mmask8 complex = _mm512_cmp_pd_mask(disc, zero, _CMP_LT_OQ);
+        __m512d root = _mm512_sqrt_pd(_mm512_abs_pd(disc));
+        
+        __mmask8 bNegative = _mm512_cmp_pd_mask(vb, zero, _CMP_LT_OQ);
+        __m512d signedRoot = _mm512_mask_blend_pd(bNegative, root, _mm512_mul_pd(minusOne, root));
+        __m512d q = _mm512_mul_pd(_mm512_add_pd(vb, signedRoot), minusHalf);
+        __m512d inverseA = _mm512_div_pd(one, va);
+        __m512d realFirst = _mm512_mul_pd(q, inverseA);
+        __mmask8 qZero = _mm512_cmp_pd_mask(q, zero, _CMP_EQ_OQ);
+        __m512d realSecond = _mm512_mask_blend_pd(qZero, _mm512_div_pd(vc, q), realFirst);
+        
+        __m512d halfInverseA = _mm512_mul_pd(inverseA, half);
+        __m512d center = _mm512_mul_pd(_mm512_mul_pd(minusOne, vb), halfInverseA);
+        __m512d spread = _mm512_mul_pd(root, _mm512_abs_pd(halfInverseA));
+        
+        _mm512_storeu_pd(real1 + i, _mm512_mask_blend_pd(complex, realFirst, center));
+        _mm512_storeu_pd(imag1 + i, _mm512_maskz_mov_pd(complex, spread));
+        _mm512_storeu_pd(real2 + i, _mm512_mask_blend_pd(complex, realSecond, center));
+        _mm512_storeu_pd(imag2 + i, _mm512_maskz_mov_pd(complex, _mm512_mul_pd(minusOne, spread)));
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть solveComplexRootsBatch() для AVX2 и FMA
+ * @return Количество обработанных элементов
+ */
+POLY_TARGET_AVX2 POLY_NO_FP_CONTRACT
+std::size_t solveComplexRootsBatchAvx2(const double* a, const double* b, const double* c, std::size_t n,
+                            double* real1, double* imag1, double* real2, double* imag2) {
+    std::size_t i = 0;
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d four = _mm256_set1_pd(4.0);
+    const __m256d minusOne = _mm256_set1_pd(-1.0);
+    const __m256d minusHalf = _mm256_set1_pd(-0.5);
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i);
+        __m256d vb = _mm256_loadu_pd(b + i);
+        __m256d vc = _mm256_loadu_pd(c + i);
+        
+        __m256d disc = _mm256_sub_pd(_mm256_mul_pd(vb, vb), _mm256_mul_pd(_mm256_mul_pd(four, va), vc));
+        __m256d complex = _mm256_cmp_pd(disc, zero, _CMP_LT_OQ);
+        __m256d root = _mm256_sqrt_pd(_mm256_andnot_pd(signBit, disc));
+        
+        __m256d bNegative = _mm256_cmp_pd(vb, zero, _CMP_LT_OQ);
+        __m256d signedRoot = _mm256_blendv_pd(root, _mm256_mul_pd(minusOne, root), bNegative);
+        __m256d q = _mm256_mul_pd(_mm256_add_pd(vb, signedRoot), minusHalf);
+        __m256d inverseA = _mm256_div_pd(one, va);
+        __m256d realFirst = _mm256_mul_pd(q, inverseA);
+        __m256d qZero = _mm256_cmp_pd(q, zero, _CMP_EQ_OQ);
+        __m256d realSecond = _mm256_blendv_pd(_mm256_div_pd(vc, q), realFirst, qZero);
+        
+        __m256d halfInverseA = _mm256_mul_pd(inverseA, half);
+        __m256d center = _mm256_mul_pd(_mm256_mul_pd(minusOne, vb), halfInverseA);
+        __m256d spread = _mm256_mul_pd(root, _mm256_andnot_pd(signBit, halfInverseA));
+        
+        _mm256_storeu_pd(real1 + i, _mm256_blendv_pd(realFirst, center, complex));
+        _mm256_storeu_pd(imag1 + i, _mm256_and_pd(complex, spread));
+        _mm256_storeu_pd(real2 + i, _mm256_blendv_pd(realSecond, center, complex));
+        _mm256_storeu_pd(imag2 + i, _mm256_and_pd(complex, _mm256_mul_pd(minusOne, spread)));
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Находит пары корней (включая комплексные) для массивов коэффициентов
+ * @param a Коэффициенты при x²
+ * @param b Коэффициенты при x
+ * @param c Свободные члены
+ * @param n Количество полиномов
+ * @param[out] real1 Действительные части первых корней
+ * @param[out] imag1 Мнимые части первых корней
+ * @param[out] real2 Действительные части вторых корней
+ * @param[out] imag2 Мнимые части вторых корней
+ * 
+ * @details
+ * Результаты совпадают с PlainPolynomial::solveQuadraticComplex(). Векторные
+ * ветви не содержат переходов, зависящих от данных: знак дискриминанта
+ * выбирает результат маской, поэтому случайные знаки не стоят ошибок
+ * предсказания. Один sqrt на полином.
+ * @note Побитовое совпадение со скалярным кодом - как у solveRootsBatch()
+ */
+void solveComplexRootsBatch(const double* a, const double* b, const double* c, std::size_t n,
+                            double* real1, double* imag1, double* real2, double* imag2) {
+    std::size_t i = 0;
+    
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = solveComplexRootsBatchAvx512(a, b, c, n, real1, imag1, real2, imag2);
+        break;
+    case KernelIsa::avx2:
+        i = solveComplexRootsBatchAvx2(a, b, c, n, real1, imag1, real2, imag2);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    
+    for (; i < n; i++) {
+        ComplexRootPair<double> pair = PlainPolynomial::solveQuadraticComplex(a[i], b[i], c[i]);
+        real1[i] = pair.real1;
+        imag1[i] = pair.imag1;
+        real2[i] = pair.real2;
+        imag2[i] = pair.imag2;
+    }
+}
+
+/**
+ * @brief Скалярный вариант solveComplexRootsBatch() для float и long double
+ */
+template <typename Scalar>
+void solveComplexRootsBatch(const Scalar* a, const Scalar* b, const Scalar* c, std::size_t n,
+                            Scalar* real1, Scalar* imag1, Scalar* real2, Scalar* imag2) {
+    for (std::size_t i = 0; i < n; i++) {
+        ComplexRootPair<Scalar> pair = BasicPolynomial<NoStatistics, Scalar>::solveQuadraticComplex(a[i], b[i], c[i]);
+        real1[i] = pair.real1;
+        imag1[i] = pair.imag1;
+        real2[i] = pair.real2;
+        imag2[i] = pair.imag2;
+    }
+}
+
+/**
+ * @brief Сравнивает значения побитово, считая любые NaN равными
+ */
+template <typename T>
+bool sameBits(T x, T y) {
+    if (x != x && y != y) {
+        return true;
+    }
+    return std::memcmp(&x, &y, sizeof(T)) == 0;
+}
+
+/**
+ * @brief Сравнивает векторные ядра корней с набором инструкций isa со скалярным кодом
+ * @param isa Проверяемый набор инструкций (должен поддерживаться процессором)
+ * @return Количество несовпадений (полиномов с другими корнями или их числом)
+ * 
+ * @details
+ * Проверяются solveRootsBatch() для double и float и solveComplexRootsBatch().
+ * Входные данные фиксированы и покрывают все ветви: линейные уравнения,
+ * константы, кратные корни, нули, бесконечности, NaN и случайные
+ * коэффициенты, на которых слияние b*b - 4*a*c в FMA меняет последний разряд.
+ */
+std::size_t countRootKernelMismatches(KernelIsa isa) {
+    const std::size_t n = 4099;
+    std::vector<double> a(n), b(n), c(n);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    auto next = [&state]() {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>(state >> 11) * 0x1.0p-53 * 20.0 - 10.0;
+    };
+    for (std::size_t i = 0; i < n; i++) {
+        a[i] = next();
+        b[i] = next();
+        c[i] = next();
+        switch (i % 8) {
+        case 0:
+            a[i] = 0.0;
+            break;
+        case 1:
+            a[i] = 0.0;
+            b[i] = (i % 16 == 1) ? 0.0 : b[i];
+            break;
+        case 2:
+            // Целые u дают точный нулевой дискриминант: (x + u)²
+            a[i] = 1.0;
+            b[i] = 2.0 * std::floor(c[i]);
+            c[i] = std::floor(c[i]) * std::floor(c[i]);
+            break;
+        case 3: {
+            const double special[] = {0.0, -0.0, INFINITY, -INFINITY, NAN};
+            c[i] = special[(i / 8) % 5];
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    std::vector<float> fa(a.begin(), a.end()), fb(b.begin(), b.end()), fc(c.begin(), c.end());
+    
+    std::vector<double> root1(n, NAN), root2(n, NAN), imag1(n), imag2(n);
+    std::vector<float> froot1(n, NAN), froot2(n, NAN);
+    std::vector<int> numRoots(n), fnumRoots(n);
+    std::size_t vectorDone = 0, floatDone = 0;
+    std::size_t mismatches = 0;
+    
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (isa) {
+    case KernelIsa::avx512:
+        vectorDone = solveRootsBatchAvx512(a.data(), b.data(), c.data(), n,
+                                           root1.data(), root2.data(), numRoots.data());
+        floatDone = solveRootsBatchAvx512(fa.data(), fb.data(), fc.data(), n,
+                                          froot1.data(), froot2.data(), fnumRoots.data());
+        break;
+    case KernelIsa::avx2:
+        vectorDone = solveRootsBatchAvx2(a.data(), b.data(), c.data(), n,
+                                         root1.data(), root2.data(), numRoots.data());
+        floatDone = solveRootsBatchAvx2(fa.data(), fb.data(), fc.data(), n,
+                                        froot1.data(), froot2.data(), fnumRoots.data());
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (std::size_t i = 0; i < vectorDone; i++) {
+        double r1 = NAN, r2 = NAN;
+        int count = 0;
+        Polynomial::solveQuadratic(a[i], b[i], c[i], r1, r2, count);
+        if (count != numRoots[i] || (count >= 1 && !sameBits(r1, root1[i])) ||
+            (count >= 2 && !sameBits(r2, root2[i]))) {
+            mismatches++;
+        }
+    }
+    for (std::size_t i = 0; i < floatDone; i++) {
+        float r1 = NAN, r2 = NAN;
+        int count = 0;
+        FloatPolynomial::solveQuadratic(fa[i], fb[i], fc[i], r1, r2, count);
+        if (count != fnumRoots[i] || (count >= 1 && !sameBits(r1, froot1[i])) ||
+            (count >= 2 && !sameBits(r2, froot2[i]))) {
+            mismatches++;
+        }
+    }
+    
+    vectorDone = 0;
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (isa) {
+    case KernelIsa::avx512:
+        vectorDone = solveComplexRootsBatchAvx512(a.data(), b.data(), c.data(), n,
+                                                  root1.data(), imag1.data(), root2.data(), imag2.data());
+        break;
+    case KernelIsa::avx2:
+        vectorDone = solveComplexRootsBatchAvx2(a.data(), b.data(), c.data(), n,
+                                                root1.data(), imag1.data(), root2.data(), imag2.data());
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (std::size_t i = 0; i < vectorDone; i++) {
+        ComplexRootPair<double> pair = PlainPolynomial::solveQuadraticComplex(a[i], b[i], c[i]);
+        if (!sameBits(pair.real1, root1[i]) || !sameBits(pair.imag1, imag1[i]) ||
+            !sameBits(pair.real2, root2[i]) || !sameBits(pair.imag2, imag2[i])) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Вычисляет (a*x + b)*x + c
+ * @details Без FMA: на процессорах без нее std::fma выполняется программно
+ * и в разы медленнее. Векторные ветви пакетных ядер вычисления значений
+ * собираются без слияния в FMA, поэтому результат совпадает с ними побитово
+ * при обычных флагах сборки (см. solveRootsBatch() о -march=native)
+ */
+inline double hornerQuadratic(double a, double b, double c, double x) {
+    return (a * x + b) * x + c;
+}
+
+/**
+ * @brief Вариант hornerQuadratic() для float
+ */
+inline float hornerQuadratic(float a, float b, float c, float x) {
+    return (a * x + b) * x + c;
+}
+
+/**
+ * @brief Вариант hornerQuadratic() для long double
+ */
+inline long double hornerQuadratic(long double a, long double b, long double c, long double x) {
+    return (a * x + b) * x + c;
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть evaluatePointsBatch() для AVX-512
+ * @return Количество обработанных элементов
+ * @details Без слияния в FMA, как hornerQuadratic(), поэтому результат
+ * совпадает со скалярным кодом побитово
+ */
+POLY_TARGET_AVX512 POLY_NO_FP_CONTRACT
+std::size_t evaluatePointsBatchAvx512(double a, double b, double c, const double* x, std::size_t n, double* out) {
+    std::size_t i = 0;
+    const __m512d va = _mm512_set1_pd(a);
+    const __m512d vb = _mm512_set1_pd(b);
+    const __m512d vc = _mm512_set1_pd(c);
+    for (; i + 32 <= n; i += 32) {
+        __m512d x0 = _mm512_loadu_pd(x + i);
+        __m512d x1 = _mm512_loadu_pd(x + i + 8);
+        __m512d x2 = _mm512_loadu_pd(x + i + 16);
+        __m512d x3 = _mm512_loadu_pd(x + i + 24);
+        __m512d p0 = _mm512_add_pd(_mm512_mul_pd(va, x0), vb);
+        _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_mul_pd(p0, x0), vc));
+        __m512d p1 = _mm512_add_pd(_mm512_mul_pd(va, x1), vb);
+        _mm512_storeu_pd(out + i + 8, _mm512_add_pd(_mm512_mul_pd(p1, x1), vc));
+        __m512d p2 = _mm512_add_pd(_mm512_mul_pd(va, x2), vb);
+        _mm512_storeu_pd(out + i + 16, _mm512_add_pd(_mm512_mul_pd(p2, x2), vc));
+        __m512d p3 = _mm512_add_pd(_mm512_mul_pd(va, x3), vb);
+        _mm512_storeu_pd(out + i + 24, _mm512_add_pd(_mm512_mul_pd(p3, x3), vc));
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m512d vx = _mm512_loadu_pd(x + i);
+        __m512d partial = _mm512_add_pd(_mm512_mul_pd(va, vx), vb);
+        _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_mul_pd(partial, vx), vc));
+    }
+    for (; i < n; i++) {
+        out[i] = (a * x[i] + b) * x[i] + c;
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть evaluatePointsBatch() для AVX2 и FMA
+ * @return Количество обработанных элементов
+ * @details Без слияния в FMA, как hornerQuadratic(), поэтому результат
+ * совпадает со скалярным кодом побитово
+ */
+POLY_TARGET_AVX2 POLY_NO_FP_CONTRACT
+std::size_t evaluatePointsBatchAvx2(double a, double b, double c, const double* x, std::size_t n, double* out) {
+    std::size_t i = 0;
+    const __m256d va = _mm256_set1_pd(a);
+    const __m256d vb = _mm256_set1_pd(b);
+    const __m256d vc = _mm256_set1_pd(c);
+    for (; i + 16 <= n; i += 16) {
+        __m256d x0 = _mm256_loadu_pd(x + i);
+        __m256d x1 = _mm256_loadu_pd(x + i + 4);
+        __m256d x2 = _mm256_loadu_pd(x + i + 8);
+        __m256d x3 = _mm256_loadu_pd(x + i + 12);
+        __m256d p0 = _mm256_add_pd(_mm256_mul_pd(va, x0), vb);
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(p0, x0), vc));
+        __m256d p1 = _mm256_add_pd(_mm256_mul_pd(va, x1), vb);
+        _mm256_storeu_pd(out + i + 4, _mm256_add_pd(_mm256_mul_pd(p1, x1), vc));
+        __m256d p2 = _mm256_add_pd(_mm256_mul_pd(va, x2), vb);
+        _mm256_storeu_pd(out + i + 8, _mm256_add_pd(_mm256_mul_pd(p2, x2), vc));
+        __m256d p3 = _mm256_add_pd(_mm256_mul_pd(va, x3), vb);
+        _mm256_storeu_pd(out + i + 12, _mm256_add_pd(_mm256_mul_pd(p3, x3), vc));
+    }
+    for (; i + 4 <= n; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d partial = _mm256_add_pd(_mm256_mul_pd(va, vx), vb);
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(partial, vx), vc));
+    }
+    for (; i < n; i++) {
+        out[i] = (a * x[i] + b) * x[i] + c;
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Вычисляет значения одного полинома в массиве точек
+ * @param a Коэффициент при x²
+ * @param b Коэффициент при x
+ * @param c Свободный член
+ * @param x Точки для вычисления
+ * @param n Количество точек
+ * @param[out] out Значения (a*x[i] + b)*x[i] + c
+ * 
+ * @details
+ * Схема Горнера: два умножения и два сложения на точку вместо трех
+ * умножений и двух сложений. Основной цикл обрабатывает четыре независимых
+ * вектора за итерацию, чтобы задержки операций перекрывались.
+ */
+void evaluatePointsBatch(double a, double b, double c, const double* x, std::size_t n, double* out) {
+    std::size_t i = 0;
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = evaluatePointsBatchAvx512(a, b, c, x, n, out);
+        break;
+    case KernelIsa::avx2:
+        i = evaluatePointsBatchAvx2(a, b, c, x, n, out);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = hornerQuadratic(a, b, c, x[i]);
+    }
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть evaluatePointsBatch() для AVX-512
+ * @return Количество обработанных элементов
+ * @details Без слияния в FMA, как hornerQuadratic(), поэтому результат
+ * совпадает со скалярным кодом побитово
+ */
+POLY_TARGET_AVX512 POLY_NO_FP_CONTRACT
+std::size_t evaluatePointsBatchAvx512(float a, float b, float c, const float* x, std::size_t n, float* out) {
+    std::size_t i = 0;
+    const __m512 va = _mm512_set1_ps(a);
+    const __m512 vb = _mm512_set1_ps(b);
+    const __m512 vc = _mm512_set1_ps(c);
+    for (; i + 64 <= n; i += 64) {
+        __m512 x0 = _mm512_loadu_ps(x + i);
+        __m512 x1 = _mm512_loadu_ps(x + i + 16);
+        __m512 x2 = _mm512_loadu_ps(x + i + 32);
+        __m512 x3 = _mm512_loadu_ps(x + i + 48);
+        __m512 p0 = _mm512_add_ps(_mm512_mul_ps(va, x0), vb);
+        _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_mul_ps(p0, x0), vc));
+        __m512 p1 = _mm512_add_ps(_mm512_mul_ps(va, x1), vb);
+        _mm512_storeu_ps(out + i + 16, _mm512_add_ps(_mm512_mul_ps(p1, x1), vc));
+        __m512 p2 = _mm512_add_ps(_mm512_mul_ps(va, x2), vb);
+        _mm512_storeu_ps(out + i + 32, _mm512_add_ps(_mm512_mul_ps(p2, x2), vc));
+        __m512 p3 = _mm512_add_ps(_mm512_mul_ps(va, x3), vb);
+        _mm512_storeu_ps(out + i + 48, _mm512_add_ps(_mm512_mul_ps(p3, x3), vc));
+    }
+    for (; i + 16 <= n; i += 16) {
+        __m512 vx = _mm512_loadu_ps(x + i);
+        __m512 partial = _mm512_add_ps(_mm512_mul_ps(va, vx), vb);
+        _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_mul_ps(partial, vx), vc));
+    }
+    for (; i < n; i++) {
+        out[i] = (a * x[i] + b) * x[i] + c;
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть evaluatePointsBatch() для AVX2 и FMA
+ * @return Количество обработанных элементов
+ * @details Без слияния в FMA, как hornerQuadratic(), поэтому результат
+ * совпадает со скалярным кодом побитово
+ */
+POLY_TARGET_AVX2 POLY_NO_FP_CONTRACT
+std::size_t evaluatePointsBatchAvx2(float a, float b, float c, const float* x, std::size_t n, float* out) {
+    std::size_t i = 0;
+    const __m256 va = _mm256_set1_ps(a);
+    const __m256 vb = _mm256_set1_ps(b);
+    const __m256 vc = _mm256_set1_ps(c);
+    for (; i + 32 <= n; i += 32) {
+        __m256 x0 = _mm256_loadu_ps(x + i);
+        __m256 x1 = _mm256_loadu_ps(x + i + 8);
+        __m256 x2 = _mm256_loadu_ps(x + i + 16);
+        __m256 x3 = _mm256_loadu_ps(x + i + 24);
+        __m256 p0 = _mm256_add_ps(_mm256_mul_ps(va, x0), vb);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(p0, x0), vc));
+        __m256 p1 = _mm256_add_ps(_mm256_mul_ps(va, x1), vb);
+        _mm256_storeu_ps(out + i + 8, _mm256_add_ps(_mm256_mul_ps(p1, x1), vc));
+        __m256 p2 = _mm256_add_ps(_mm256_mul_ps(va, x2), vb);
+        _mm256_storeu_ps(out + i + 16, _mm256_add_ps(_mm256_mul_ps(p2, x2), vc));
+        __m256 p3 = _mm256_add_ps(_mm256_mul_ps(va, x3), vb);
+        _mm256_storeu_ps(out + i + 24, _mm256_add_ps(_mm256_mul_ps(p3, x3), vc));
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 vx = _mm256_loadu_ps(x + i);
+        __m256 partial = _mm256_add_ps(_mm256_mul_ps(va, vx), vb);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(partial, vx), vc));
+    }
+    for (; i < n; i++) {
+        out[i] = (a * x[i] + b) * x[i] + c;
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Вариант evaluatePointsBatch() для float
+ * @details Вектор вмещает 16 (AVX-512) или 8 (AVX2) точек
+ */
+void evaluatePointsBatch(float a, float b, float c, const float* x, std::size_t n, float* out) {
+    std::size_t i = 0;
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = evaluatePointsBatchAvx512(a, b, c, x, n, out);
+        break;
+    case KernelIsa::avx2:
+        i = evaluatePointsBatchAvx2(a, b, c, x, n, out);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = hornerQuadratic(a, b, c, x[i]);
+    }
+}
+
+/**
+ * @brief Вариант evaluatePointsBatch() для long double (скалярный)
+ */
+void evaluatePointsBatch(long double a, long double b, long double c, const long double* x,
+                         std::size_t n, long double* out) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = hornerQuadratic(a, b, c, x[i]);
+    }
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть evaluateBatch() для AVX-512
+ * @return Количество обработанных элементов
+ * @details Без слияния в FMA, как hornerQuadratic(), поэтому результат
+ * совпадает со скалярным кодом побитово
+ */
+POLY_TARGET_AVX512 POLY_NO_FP_CONTRACT
+std::size_t evaluateBatchAvx512(const double* a, const double* b, const double* c, std::size_t n,
+                   double x, double* out) {
+    std::size_t i = 0;
+    const __m512d vx = _mm512_set1_pd(x);
+    for (; i + 8 <= n; i += 8) {
+        __m512d partial = _mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(a + i), vx), _mm512_loadu_pd(b + i));
+        _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_mul_pd(partial, vx), _mm512_loadu_pd(c + i)));
+    }
+    for (; i < n; i++) {
+        out[i] = (a[i] * x + b[i]) * x + c[i];
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть evaluateBatch() для AVX2 и FMA
+ * @return Количество обработанных элементов
+ * @details Без слияния в FMA, как hornerQuadratic(), поэтому результат
+ * совпадает со скалярным кодом побитово
+ */
+POLY_TARGET_AVX2 POLY_NO_FP_CONTRACT
+std::size_t evaluateBatchAvx2(const double* a, const double* b, const double* c, std::size_t n,
+                   double x, double* out) {
+    std::size_t i = 0;
+    const __m256d vx = _mm256_set1_pd(x);
+    for (; i + 4 <= n; i += 4) {
+        __m256d partial = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(a + i), vx), _mm256_loadu_pd(b + i));
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(partial, vx), _mm256_loadu_pd(c + i)));
+    }
+    for (; i < n; i++) {
+        out[i] = (a[i] * x + b[i]) * x + c[i];
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Вычисляет значения массива полиномов в одной точке
+ * @param a Коэффициенты при x²
+ * @param b Коэффициенты при x
+ * @param c Свободные члены
+ * @param n Количество полиномов
+ * @param x Точка для вычисления
+ * @param[out] out Значения (a[i]*x + b[i])*x + c[i]
+ * @note Схема Горнера, как в evaluatePointsBatch()
+ */
+void evaluateBatch(const double* a, const double* b, const double* c, std::size_t n,
+                   double x, double* out) {
+    std::size_t i = 0;
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = evaluateBatchAvx512(a, b, c, n, x, out);
+        break;
+    case KernelIsa::avx2:
+        i = evaluateBatchAvx2(a, b, c, n, x, out);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = hornerQuadratic(a[i], b[i], c[i], x);
+    }
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть evaluateBatch() для AVX-512
+ * @return Количество обработанных элементов
+ * @details Без слияния в FMA, как hornerQuadratic(), поэтому результат
+ * совпадает со скалярным кодом побитово
+ */
+POLY_TARGET_AVX512 POLY_NO_FP_CONTRACT
+std::size_t evaluateBatchAvx512(const float* a, const float* b, const float* c, std::size_t n,
+                   float x, float* out) {
+    std::size_t i = 0;
+    const __m512 vx = _mm512_set1_ps(x);
+    for (; i + 16 <= n; i += 16) {
+        __m512 partial = _mm512_add_ps(_mm512_mul_ps(_mm512_loadu_ps(a + i), vx), _mm512_loadu_ps(b + i));
+        _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_mul_ps(partial, vx), _mm512_loadu_ps(c + i)));
+    }
+    for (; i < n; i++) {
+        out[i] = (a[i] * x + b[i]) * x + c[i];
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть evaluateBatch() для AVX2 и FMA
+ * @return Количество обработанных элементов
+ * @details Без слияния в FMA, как hornerQuadratic(), поэтому результат
+ * совпадает со скалярным кодом побитово
+ */
+POLY_TARGET_AVX2 POLY_NO_FP_CONTRACT
+std::size_t evaluateBatchAvx2(const float* a, const float* b, const float* c, std::size_t n,
+                   float x, float* out) {
+    std::size_t i = 0;
+    const __m256 vx = _mm256_set1_ps(x);
+    for (; i + 8 <= n; i += 8) {
+        __m256 partial = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a + i), vx), _mm256_loadu_ps(b + i));
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(partial, vx), _mm256_loadu_ps(c + i)));
+    }
+    for (; i < n; i++) {
+        out[i] = (a[i] * x + b[i]) * x + c[i];
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Вариант evaluateBatch() для float
+ */
+void evaluateBatch(const float* a, const float* b, const float* c, std::size_t n,
+                   float x, float* out) {
+    std::size_t i = 0;
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = evaluateBatchAvx512(a, b, c, n, x, out);
+        break;
+    case KernelIsa::avx2:
+        i = evaluateBatchAvx2(a, b, c, n, x, out);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = hornerQuadratic(a[i], b[i], c[i], x);
+    }
+}
+
+/**
+ * @brief Вариант evaluateBatch() для long double (скалярный)
+ */
+void evaluateBatch(const long double* a, const long double* b, const long double* c, std::size_t n,
+                   long double x, long double* out) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = hornerQuadratic(a[i], b[i], c[i], x);
+    }
+}
+
+/**
+ * @brief Сравнивает векторные ядра вычисления значений с набором инструкций isa со скалярным кодом
+ * @param isa Проверяемый набор инструкций (должен поддерживаться процессором)
+ * @return Количество значений, отличающихся от hornerQuadratic() хотя бы одним битом
+ * @details Проверяются evaluatePointsBatch() и evaluateBatch() для double и float
+ * на случайных коэффициентах и точках; длина массивов не кратна ширине вектора,
+ * чтобы проверить и остаток
+ */
+std::size_t countEvaluateKernelMismatches(KernelIsa isa) {
+    const std::size_t n = 4099;
+    std::vector<double> a(n), b(n), c(n), x(n);
+    std::uint64_t state = 0xD1B54A32D192ED03ull;
+    auto next = [&state]() {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>(state >> 11) * 0x1.0p-53 * 20.0 - 10.0;
+    };
+    for (std::size_t i = 0; i < n; i++) {
+        a[i] = next();
+        b[i] = next();
+        c[i] = next();
+        x[i] = next();
+    }
+    std::vector<float> fa(a.begin(), a.end()), fb(b.begin(), b.end()), fc(c.begin(), c.end());
+    std::vector<float> fx(x.begin(), x.end());
+    const double point = 3.7;
+    const float fpoint = 3.7f;
+    
+    std::vector<double> points(n), rows(n);
+    std::vector<float> fpoints(n), frows(n);
+    std::size_t pointsDone = 0, rowsDone = 0, fpointsDone = 0, frowsDone = 0;
+    std::size_t mismatches = 0;
+    
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (isa) {
+    case KernelIsa::avx512:
+        pointsDone = evaluatePointsBatchAvx512(a[0], b[0], c[0], x.data(), n, points.data());
+        fpointsDone = evaluatePointsBatchAvx512(fa[0], fb[0], fc[0], fx.data(), n, fpoints.data());
+        rowsDone = evaluateBatchAvx512(a.data(), b.data(), c.data(), n, point, rows.data());
+        frowsDone = evaluateBatchAvx512(fa.data(), fb.data(), fc.data(), n, fpoint, frows.data());
+        break;
+    case KernelIsa::avx2:
+        pointsDone = evaluatePointsBatchAvx2(a[0], b[0], c[0], x.data(), n, points.data());
+        fpointsDone = evaluatePointsBatchAvx2(fa[0], fb[0], fc[0], fx.data(), n, fpoints.data());
+        rowsDone = evaluateBatchAvx2(a.data(), b.data(), c.data(), n, point, rows.data());
+        frowsDone = evaluateBatchAvx2(fa.data(), fb.data(), fc.data(), n, fpoint, frows.data());
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (std::size_t i = 0; i < pointsDone; i++) {
+        if (!sameBits(hornerQuadratic(a[0], b[0], c[0], x[i]), points[i])) {
+            mismatches++;
+        }
+    }
+    for (std::size_t i = 0; i < fpointsDone; i++) {
+        if (!sameBits(hornerQuadratic(fa[0], fb[0], fc[0], fx[i]), fpoints[i])) {
+            mismatches++;
+        }
+    }
+    for (std::size_t i = 0; i < rowsDone; i++) {
+        if (!sameBits(hornerQuadratic(a[i], b[i], c[i], point), rows[i])) {
+            mismatches++;
+        }
+    }
+    for (std::size_t i = 0; i < frowsDone; i++) {
+        if (!sameBits(hornerQuadratic(fa[i], fb[i], fc[i], fpoint), frows[i])) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть updateColumn() для AVX-512
+ * @return Количество обработанных элементов
+ */
+template <typename Scalar, typename Op>
+POLY_TARGET_AVX512 std::size_t updateColumnAvx512(Scalar* column, std::size_t n, Op op) {
+    std::size_t i = 0;
+    if constexpr (std::is_same<Scalar, double>::value) {
+        for (; i + 8 <= n; i += 8) {
+            auto value = _mm512_loadu_pd(column + i);
+            op(value);
+            _mm512_storeu_pd(column + i, value);
+        }
+    } else if constexpr (std::is_same<Scalar, float>::value) {
+        for (; i + 16 <= n; i += 16) {
+            auto value = _mm512_loadu_ps(column + i);
+            op(value);
+            _mm512_storeu_ps(column + i, value);
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть updateColumn() для AVX2
+ * @return Количество обработанных элементов
+ */
+template <typename Scalar, typename Op>
+POLY_TARGET_AVX2 std::size_t updateColumnAvx2(Scalar* column, std::size_t n, Op op) {
+    std::size_t i = 0;
+    if constexpr (std::is_same<Scalar, double>::value) {
+        for (; i + 4 <= n; i += 4) {
+            auto value = _mm256_loadu_pd(column + i);
+            op(value);
+            _mm256_storeu_pd(column + i, value);
+        }
+    } else if constexpr (std::is_same<Scalar, float>::value) {
+        for (; i + 8 <= n; i += 8) {
+            auto value = _mm256_loadu_ps(column + i);
+            op(value);
+            _mm256_storeu_ps(column + i, value);
+        }
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Поэлементно преобразует колонку на месте
+ * @param column Колонка коэффициентов (double, float или long double)
+ * @param n Количество элементов
+ * @param op Обобщенная лямбда op(value), изменяющая value на месте; применима
+ *       и к скаляру, и к векторному регистру
+ * @note Арифметика над __m512d/__m256d - векторные расширения GCC/Clang,
+ *       поэтому одна лямбда задает и векторный цикл, и скалярный хвост.
+ *       Значение передается по ссылке: векторный тип в параметре или
+ *       результате функции без атрибута target менял бы ABI вызова.
+ *       Константы в лямбде должны иметь тип Scalar: векторы float не
+ *       смешиваются со скалярами double
+ */
+template <typename Scalar, typename Op>
+void updateColumn(Scalar* column, std::size_t n, Op op) {
+    std::size_t i = 0;
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = updateColumnAvx512(column, n, op);
+        break;
+    case KernelIsa::avx2:
+        i = updateColumnAvx2(column, n, op);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (; i < n; i++) {
+        op(column[i]);
+    }
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть combineColumn() для AVX-512
+ * @return Количество обработанных элементов
+ */
+template <typename Scalar, typename Op>
+POLY_TARGET_AVX512 std::size_t combineColumnAvx512(Scalar* column, const Scalar* operand, std::size_t n, Op op) {
+    std::size_t i = 0;
+    if constexpr (std::is_same<Scalar, double>::value) {
+        for (; i + 8 <= n; i += 8) {
+            auto value = _mm512_loadu_pd(column + i);
+            auto other = _mm512_loadu_pd(operand + i);
+            op(value, other);
+            _mm512_storeu_pd(column + i, value);
+        }
+    } else if constexpr (std::is_same<Scalar, float>::value) {
+        for (; i + 16 <= n; i += 16) {
+            auto value = _mm512_loadu_ps(column + i);
+            auto other = _mm512_loadu_ps(operand + i);
+            op(value, other);
+            _mm512_storeu_ps(column + i, value);
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть combineColumn() для AVX2
+ * @return Количество обработанных элементов
+ */
+template <typename Scalar, typename Op>
+POLY_TARGET_AVX2 std::size_t combineColumnAvx2(Scalar* column, const Scalar* operand, std::size_t n, Op op) {
+    std::size_t i = 0;
+    if constexpr (std::is_same<Scalar, double>::value) {
+        for (; i + 4 <= n; i += 4) {
+            auto value = _mm256_loadu_pd(column + i);
+            auto other = _mm256_loadu_pd(operand + i);
+            op(value, other);
+            _mm256_storeu_pd(column + i, value);
+        }
+    } else if constexpr (std::is_same<Scalar, float>::value) {
+        for (; i + 8 <= n; i += 8) {
+            auto value = _mm256_loadu_ps(column + i);
+            auto other = _mm256_loadu_ps(operand + i);
+            op(value, other);
+            _mm256_storeu_ps(column + i, value);
+        }
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Поэлементно объединяет колонку с другой колонкой на месте
+ * @param column Изменяемая колонка
+ * @param operand Второй операнд (может совпадать с column)
+ * @param n Количество элементов
+ * @param op Обобщенная лямбда op(value, operand), изменяющая value на месте
+ */
+template <typename Scalar, typename Op>
+void combineColumn(Scalar* column, const Scalar* operand, std::size_t n, Op op) {
+    std::size_t i = 0;
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = combineColumnAvx512(column, operand, n, op);
+        break;
+    case KernelIsa::avx2:
+        i = combineColumnAvx2(column, operand, n, op);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (; i < n; i++) {
+        op(column[i], operand[i]);
+    }
+}
+
+/**
+ * @brief Выставляет флаги нулевых делителей по битовой маске вектора
+ * @param zeroFlags Флаги делителей
+ * @param first Индекс первого элемента вектора
+ * @param mask Биты элементов вектора, равных нулю
+ * @return Количество выставленных флагов
+ */
+inline std::size_t flagZeroLanes(unsigned char* zeroFlags, std::size_t first, unsigned mask) {
+    std::size_t zeros = 0;
+    for (unsigned lane = 0; mask != 0; lane++, mask >>= 1) {
+        if (mask & 1u) {
+            zeroFlags[first + lane] = 1;
+            zeros++;
+        }
+    }
+    return zeros;
+}
+
+#if defined(POLY_KERNEL_DISPATCH)
+/**
+ * @brief Векторная часть maskZeroDivisors() для AVX-512
+ * @param[in,out] zeros Счетчик нулевых делителей
+ * @return Количество обработанных элементов
+ */
+template <typename Scalar>
+POLY_TARGET_AVX512 std::size_t maskZeroDivisorsAvx512(const Scalar* divisors, std::size_t n, Scalar* safe,
+                                                      unsigned char* zeroFlags, std::size_t& zeros) {
+    std::size_t i = 0;
+    if constexpr (std::is_same<Scalar, double>::value) {
+        for (; i + 8 <= n; i += 8) {
+            __m512d d = _mm512_loadu_pd(divisors + i);
+            __mmask8 mask = _mm512_cmp_pd_mask(d, _mm512_setzero_pd(), _CMP_EQ_OQ);
+            _mm512_storeu_pd(safe + i, _mm512_mask_blend_pd(mask, d, _mm512_set1_pd(1.0)));
+            if (mask != 0) {
+                zeros += flagZeroLanes(zeroFlags, i, mask);
+            }
+        }
+    } else if constexpr (std::is_same<Scalar, float>::value) {
+        for (; i + 16 <= n; i += 16) {
+            __m512 d = _mm512_loadu_ps(divisors + i);
+            __mmask16 mask = _mm512_cmp_ps_mask(d, _mm512_setzero_ps(), _CMP_EQ_OQ);
+            _mm512_storeu_ps(safe + i, _mm512_mask_blend_ps(mask, d, _mm512_set1_ps(1.0f)));
+            if (mask != 0) {
+                zeros += flagZeroLanes(zeroFlags, i, mask);
+            }
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Векторная часть maskZeroDivisors() для AVX2
+ * @param[in,out] zeros Счетчик нулевых делителей
+ * @return Количество обработанных элементов
+ */
+template <typename Scalar>
+POLY_TARGET_AVX2 std::size_t maskZeroDivisorsAvx2(const Scalar* divisors, std::size_t n, Scalar* safe,
+                                                  unsigned char* zeroFlags, std::size_t& zeros) {
+    std::size_t i = 0;
+    if constexpr (std::is_same<Scalar, double>::value) {
+        for (; i + 4 <= n; i += 4) {
+            __m256d d = _mm256_loadu_pd(divisors + i);
+            __m256d isZero = _mm256_cmp_pd(d, _mm256_setzero_pd(), _CMP_EQ_OQ);
+            _mm256_storeu_pd(safe + i, _mm256_blendv_pd(d, _mm256_set1_pd(1.0), isZero));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(isZero));
+            if (mask != 0) {
+                zeros += flagZeroLanes(zeroFlags, i, mask);
+            }
+        }
+    } else if constexpr (std::is_same<Scalar, float>::value) {
+        for (; i + 8 <= n; i += 8) {
+            __m256 d = _mm256_loadu_ps(divisors + i);
+            __m256 isZero = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_EQ_OQ);
+            _mm256_storeu_ps(safe + i, _mm256_blendv_ps(d, _mm256_set1_ps(1.0f), isZero));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(isZero));
+            if (mask != 0) {
+                zeros += flagZeroLanes(zeroFlags, i, mask);
+            }
+        }
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Готовит делители для пакетного деления с маской ошибок
+ * @param divisors Исходные делители
+ * @param n Количество делителей
+ * @param[out] safe Делители, в которых нули заменены единицей
+ * @param[out] zeroFlags Флаги: 1, если делитель равен 0
+ * @return Количество нулевых делителей
+ * @details Нулевые делители редки: векторные варианты выставляют флаги
+ * только для векторов, в которых они есть
+ */
+template <typename Scalar>
+std::size_t maskZeroDivisors(const Scalar* divisors, std::size_t n, Scalar* safe,
+                             unsigned char* zeroFlags) {
+    std::memset(zeroFlags, 0, n);
+    std::size_t zeros = 0;
+    std::size_t i = 0;
+#if defined(POLY_KERNEL_DISPATCH)
+    switch (activeKernelIsa) {
+    case KernelIsa::avx512:
+        i = maskZeroDivisorsAvx512(divisors, n, safe, zeroFlags, zeros);
+        break;
+    case KernelIsa::avx2:
+        i = maskZeroDivisorsAvx2(divisors, n, safe, zeroFlags, zeros);
+        break;
+    case KernelIsa::scalar:
+        break;
+    }
+#endif
+    for (; i < n; i++) {
+        bool isZero = divisors[i] == 0;
+        safe[i] = isZero ? Scalar(1) : divisors[i];
+        zeroFlags[i] = isZero;
+        zeros += isZero;
+    }
+    return zeros;
+}
+
+/** @} */ // конец группы BatchKernels
+
+/**
+ * @defgroup HelperStructures Вспомогательные структуры
+ * @brief Структуры для поддержки работы программы
+ * @{
+ */
+
+/**
+ * @struct BasicCoefficientSpan
+ * @brief Невладеющее представление колонок коэффициентов
+ * @tparam Scalar Тип коэффициентов
+ * 
+ * @details
+ * Указывает на чужую память (PolynomialArray, отображенный файл
+ * коэффициентов) и передается пакетным ядрам без копирования.
+ */
+template <typename Scalar>
+struct BasicCoefficientSpan {
+    const Scalar* a;    ///< Коэффициенты при x²
+    const Scalar* b;    ///< Коэффициенты при x
+    const Scalar* c;    ///< Свободные члены
+    std::size_t count;  ///< Количество полиномов
+};
+
+/**
+ * @typedef CoefficientSpan
+ * @brief Колонки коэффициентов в double
+ */
+typedef BasicCoefficientSpan<double> CoefficientSpan;
+
+/**
+ * @brief Вычисляет значения набора полиномов в одной точке
+ * @param polynomials Колонки коэффициентов
+ * @param x Точка для вычисления
+ * @param[out] out Массив из polynomials.count значений
+ */
+template <typename Scalar>
+inline void evaluateMany(const BasicCoefficientSpan<Scalar>& polynomials, Scalar x, Scalar* out) {
+    evaluateBatch(polynomials.a, polynomials.b, polynomials.c, polynomials.count, x, out);
+}
+
+/**
+ * @struct BasicPolynomialArray
+ * @brief Колоночное (SoA) хранилище квадратных полиномов
+ * @tparam Scalar Тип коэффициентов: double, float или long double
+ * 
+ * @details
+ * Коэффициенты хранятся в трех отдельных непрерывных массивах a[], b[] и c[],
+ * каждый из которых выровнен по границе кэш-линии. Объекты Polynomial внутри
+ * не создаются, поэтому рост массива не вызывает конструкторов и не влияет
+ * на статистику класса. Обходы evaluate() и findRoots() читают колонки
+ * последовательно, без шага в размер целого объекта.
+ * 
+ * Колонки выделяются из ресурса памяти std::pmr, заданного при создании.
+ * По умолчанию это ресурс процесса по умолчанию (глобальный operator new);
+ * долгоживущие массивы можно разместить на арене сессии
+ * (PolynomialStatistics::sessionResource()) или на локальной арене потока,
+ * чтобы рост не обращался к общему распределителю.
+ */
+template <typename Scalar>
+struct BasicPolynomialArray {
+    static const std::size_t alignment = 64; ///< Выравнивание колонок (размер кэш-линии)
+    
+    std::pmr::memory_resource* resource; ///< Источник памяти для колонок
+    Scalar* a;              ///< Колонка коэффициентов при x²
+    Scalar* b;              ///< Колонка коэффициентов при x
+    Scalar* c;              ///< Колонка свободных членов
+    std::size_t capacity;   ///< Текущая емкость каждой колонки
+    std::size_t count;      ///< Количество полиномов в массиве
+    
+    /**
+     * @brief Конструктор
+     * @param memory Ресурс памяти для колонок; должен жить дольше массива
+     * @post Инициализирует пустой массив
+     */
+    explicit BasicPolynomialArray(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : resource(memory), a(nullptr), b(nullptr), c(nullptr), capacity(0), count(0) {}
+    
+    BasicPolynomialArray(const BasicPolynomialArray&) = delete;
+    BasicPolynomialArray& operator=(const BasicPolynomialArray&) = delete;
+    
+    /**
+     * @brief Резервирует память под заданное количество полиномов
+     * @param minCapacity Требуемая емкость
+     * @post capacity >= minCapacity, существующие элементы сохранены
+     */
+    void reserve(std::size_t minCapacity) {
+        if (minCapacity <= capacity) {
+            return;
+        }
+        
+        // Емкость округляется до целого числа кэш-линий в каждой колонке
+        const std::size_t perLine = alignment / sizeof(Scalar);
+        std::size_t newCapacity = (minCapacity + perLine - 1) / perLine * perLine;
+        
+        Scalar* newA = allocateColumn(newCapacity);
+        Scalar* newB = allocateColumn(newCapacity);
+        Scalar* newC = allocateColumn(newCapacity);
+        
+        if (count > 0) {
+            std::memcpy(newA, a, count * sizeof(Scalar));
+            std::memcpy(newB, b, count * sizeof(Scalar));
+            std::memcpy(newC, c, count * sizeof(Scalar));
+        }
+        
+        freeColumn(a, capacity);
+        freeColumn(b, capacity);
+        freeColumn(c, capacity);
+        
+        a = newA;
+        b = newB;
+        c = newC;
+        capacity = newCapacity;
+    }
+    
+    /**
+     * @brief Добавляет полином, заданный коэффициентами
+     * @param aVal Коэффициент при x²
+     * @param bVal Коэффициент при x
+     * @param cVal Свободный член
+     * @post Массив автоматически расширяется при необходимости
+     */
+    void emplace(Scalar aVal, Scalar bVal, Scalar cVal) {
+        if (count >= capacity) {
+            reserve(capacity == 0 ? alignment / sizeof(Scalar) : capacity * 2);
+        }
+        
+        a[count] = aVal;
+        b[count] = bVal;
+        c[count] = cVal;
+        count++;
+    }
+    
+    /**
+     * @brief Добавляет полином в массив
+     * @param p Полином для добавления
+     * @post Массив автоматически расширяется при необходимости
+     * @details Для полиномов со статистикой задержка учитывается в гистограмме
+     * arrayAddLatency, включая перевыделение колонок
+     */
+    template <typename StatsPolicy, typename Precision>
+    void add(const BasicPolynomial<StatsPolicy, Precision>& p) {
+        const std::uint64_t started = StatsPolicy::latencyStart();
+        emplace(p.getA(), p.getB(), p.getC());
+        StatsPolicy::onLatency(arrayAddLatency, started);
+    }
+    
+    /**
+     * @brief Добавляет сразу n полиномов из колонок коэффициентов
+     * @param aSrc Коэффициенты при x²
+     * @param bSrc Коэффициенты при x
+     * @param cSrc Свободные члены
+     * @param n Количество добавляемых полиномов
+     */
+    void append(const Scalar* aSrc, const Scalar* bSrc, const Scalar* cSrc, std::size_t n) {
+        if (n == 0) {
+            return;
+        }
+        if (count + n > capacity) {
+            reserve(count + n > capacity * 2 ? count + n : capacity * 2);
+        }
+        
+        std::memcpy(a + count, aSrc, n * sizeof(Scalar));
+        std::memcpy(b + count, bSrc, n * sizeof(Scalar));
+        std::memcpy(c + count, cSrc, n * sizeof(Scalar));
+        count += n;
+    }
+    
+    /**
+     * @brief Возвращает полином с заданным индексом
+     * @param index Индекс элемента (0 <= index < count)
+     * @return Новый объект Polynomial той же точности с коэффициентами элемента
+     */
+    BasicPolynomial<FullStatistics, Scalar> get(std::size_t index) const {
+        return BasicPolynomial<FullStatistics, Scalar>(a[index], b[index], c[index]);
+    }
+    
+    /**
+     * @brief Возвращает представление полинома с заданным индексом
+     * @param index Индекс элемента (0 <= index < count)
+     * @return Копия коэффициентов элемента, которая, в отличие от get(), не
+     * учитывается как новый экземпляр и не попадает в журнал удалений
+     * @details Для вывода элементов и их изменения на месте с последующим set()
+     */
+    BasicPolynomial<ViewStatistics, Scalar> view(std::size_t index) const {
+        return BasicPolynomial<ViewStatistics, Scalar>(a[index], b[index], c[index]);
+    }
+    
+    /**
+     * @brief Записывает коэффициенты полинома в элемент массива
+     * @param index Индекс элемента (0 <= index < count)
+     * @param p Полином-источник
+     */
+    template <typename StatsPolicy, typename Precision>
+    void set(std::size_t index, const BasicPolynomial<StatsPolicy, Precision>& p) {
+        a[index] = p.getA();
+        b[index] = p.getB();
+        c[index] = p.getC();
+    }
+    
+    /**
+     * @brief Переставляет полиномы в заданном порядке
+     * @param order Перестановка индексов: новый i-й элемент - бывший order[i]
+     * @pre order содержит каждый индекс 0..count-1 ровно один раз
+     */
+    void permute(const std::size_t* order) {
+        if (count == 0) {
+            return;
+        }
+        Scalar* columns[3] = {a, b, c};
+        for (Scalar*& column : columns) {
+            Scalar* permuted = allocateColumn(capacity);
+            for (std::size_t i = 0; i < count; i++) {
+                permuted[i] = column[order[i]];
+            }
+            freeColumn(column, capacity);
+            column = permuted;
+        }
+        a = columns[0];
+        b = columns[1];
+        c = columns[2];
+    }
+
+    /**
+     * @defgroup ArrayArithmetic Поэлементная арифметика массива
+     * @brief Аналоги операторов Polynomial для всех элементов сразу
+     *
+     * @details
+     * Операции проходят по колонкам векторными циклами и не создают объектов
+     * Polynomial, поэтому не меняют счетчики экземпляров. Результат каждого
+     * элемента совпадает с результатом соответствующего оператора Polynomial.
+     * Все проверки выполняются до первой записи: при исключении массив не изменен.
+     * @{
+     */
+
+    /**
+     * @brief Поэлементное сложение с другим массивом
+     * @param other Массив того же размера (может быть *this)
+     * @return Ссылка на текущий массив
+     * @throws std::invalid_argument если размеры массивов различаются
+     */
+    BasicPolynomialArray& operator+=(const BasicPolynomialArray& other) {
+        requireSameSize(other);
+        auto add = [](auto& x, const auto& y) { x += y; };
+        combineColumn(a, other.a, count, add);
+        combineColumn(b, other.b, count, add);
+        combineColumn(c, other.c, count, add);
+        return *this;
+    }
+
+    /**
+     * @brief Поэлементное вычитание другого массива
+     * @param other Массив того же размера (может быть *this)
+     * @return Ссылка на текущий массив
+     * @throws std::invalid_argument если размеры массивов различаются
+     */
+    BasicPolynomialArray& operator-=(const BasicPolynomialArray& other) {
+        requireSameSize(other);
+        auto subtract = [](auto& x, const auto& y) { x -= y; };
+        combineColumn(a, other.a, count, subtract);
+        combineColumn(b, other.b, count, subtract);
+        combineColumn(c, other.c, count, subtract);
+        return *this;
+    }
+
+    /**
+     * @brief Умножение всех полиномов на скаляр
+     * @param scalar Множитель
+     * @return Ссылка на текущий массив
+     */
+    BasicPolynomialArray& operator*=(Scalar scalar) {
+        auto multiply = [scalar](auto& x) { x *= scalar; };
+        updateColumn(a, count, multiply);
+        updateColumn(b, count, multiply);
+        updateColumn(c, count, multiply);
+        return *this;
+    }
+
+    /**
+     * @brief Деление всех полиномов на скаляр
+     * @param scalar Делитель
+     * @return Ссылка на текущий массив
+     * @throws std::invalid_argument если scalar = 0
+     */
+    BasicPolynomialArray& operator/=(Scalar scalar) {
+        if (scalar == 0) {
+            throw std::invalid_argument("Delenie na nol!");
+        }
+        auto divide = [scalar](auto& x) { x /= scalar; };
+        updateColumn(a, count, divide);
+        updateColumn(b, count, divide);
+        updateColumn(c, count, divide);
+        return *this;
+    }
+
+    /**
+     * @brief Умножение каждого полинома на свой множитель
+     * @param factors Массив из count множителей
+     */
+    void scale(const Scalar* factors) {
+        auto multiply = [](auto& x, const auto& y) { x *= y; };
+        combineColumn(a, factors, count, multiply);
+        combineColumn(b, factors, count, multiply);
+        combineColumn(c, factors, count, multiply);
+    }
+
+    /**
+     * @brief Деление каждого полинома на свой делитель
+     * @param divisors Массив из count делителей
+     * @param[out] errorMask Массив из count флагов: 1, если делитель равен 0
+     *                       (может быть nullptr)
+     * @return Количество элементов с нулевым делителем
+     * @post Элементы с нулевым делителем не изменяются, остальные разделены.
+     *       В отличие от Polynomial::operator/= ошибка не прерывает пакет
+     */
+    std::size_t divide(const Scalar* divisors, unsigned char* errorMask) {
+        // Нулевые делители заменяются единицей в буфере на стеке, поэтому деление
+        // остается векторным, а соответствующие элементы не меняются
+        const std::size_t blockSize = 256;
+        Scalar safeDivisors[blockSize];
+        unsigned char zeroFlags[blockSize];
+        std::size_t errors = 0;
+        auto divideBy = [](auto& x, const auto& y) { x /= y; };
+        for (std::size_t begin = 0; begin < count; begin += blockSize) {
+            std::size_t n = count - begin < blockSize ? count - begin : blockSize;
+            errors += maskZeroDivisors(divisors + begin, n, safeDivisors, zeroFlags);
+            if (errorMask != nullptr) {
+                std::memcpy(errorMask + begin, zeroFlags, n);
+            }
+            combineColumn(a + begin, safeDivisors, n, divideBy);
+            combineColumn(b + begin, safeDivisors, n, divideBy);
+            combineColumn(c + begin, safeDivisors, n, divideBy);
+        }
+        return errors;
+    }
+
+    /**
+     * @brief Префиксный инкремент всех полиномов
+     * @return Ссылка на текущий массив
+     * @post Увеличивает все коэффициенты на 1
+     */
+    BasicPolynomialArray& operator++() {
+        auto increment = [](auto& x) { x += Scalar(1); };
+        updateColumn(a, count, increment);
+        updateColumn(b, count, increment);
+        updateColumn(c, count, increment);
+        return *this;
+    }
+
+    /**
+     * @brief Префиксный декремент всех полиномов
+     * @return Ссылка на текущий массив
+     * @post Уменьшает все коэффициенты на 1
+     */
+    BasicPolynomialArray& operator--() {
+        auto decrement = [](auto& x) { x -= Scalar(1); };
+        updateColumn(a, count, decrement);
+        updateColumn(b, count, decrement);
+        updateColumn(c, count, decrement);
+        return *this;
+    }
+
+    /** @} */ // конец группы ArrayArithmetic
+
+    /**
+     * @brief Вычисляет значения всех полиномов в точке x
+     * @param x Точка для вычисления
+     * @param[out] out Массив из count значений
+     */
+    void evaluate(Scalar x, Scalar* out) const {
+        PerfCounterScope scope(evaluatePerf, count);
+        evaluateBatch(a, b, c, count, x, out);
+    }
+    
+    /**
+     * @brief Находит корни всех полиномов массива
+     * @param[out] root1 Массив первых корней (NaN, если корня нет)
+     * @param[out] root2 Массив вторых корней (NaN, если корня нет)
+     * @param[out] numRoots Массив количеств корней
+     * @note В отличие от Polynomial::findRoots() не ведет статистику вычислений.
+     * Для массива float корни можно запросить в double: тогда дискриминант
+     * считается в double (смешанная точность, см. MixedPrecision)
+     */
+    template <typename Root>
+    void findRoots(Root* root1, Root* root2, int* numRoots) const {
+        PerfCounterScope scope(findRootsPerf, count);
+        solveRootsBatch(a, b, c, count, root1, root2, numRoots);
+    }
+    
+    /**
+     * @brief Находит пары корней всех полиномов, включая комплексные
+     * @param[out] real1 Действительные части первых корней
+     * @param[out] imag1 Мнимые части первых корней
+     * @param[out] real2 Действительные части вторых корней
+     * @param[out] imag2 Мнимые части вторых корней
+     * @see solveComplexRootsBatch()
+     */
+    void findComplexRoots(Scalar* real1, Scalar* imag1, Scalar* real2, Scalar* imag2) const {
+        solveComplexRootsBatch(a, b, c, count, real1, imag1, real2, imag2);
+    }
+    
+    /**
+     * @brief Возвращает представление колонок без копирования
+     * @warning Становится недействительным после reserve(), emplace() и clear()
+     */
+    BasicCoefficientSpan<Scalar> span() const {
+        BasicCoefficientSpan<Scalar> result = {a, b, c, count};
+        return result;
+    }
+    
+    /**
+     * @brief Очищает массив
+     * @post Освобождает всю занятую память
+     */
+    void clear() {
+        freeColumn(a, capacity);
+        freeColumn(b, capacity);
+        freeColumn(c, capacity);
+        a = nullptr;
+        b = nullptr;
+        c = nullptr;
+        capacity = 0;
+        count = 0;
+    }
+    
+    /**
+     * @brief Деструктор
+     * @post Автоматически вызывает clear()
+     */
+    ~BasicPolynomialArray() {
+        clear();
+    }
+
+private:
+    /**
+     * @brief Проверяет, что размеры массивов совпадают
+     * @param other Второй операнд поэлементной операции
+     * @throws std::invalid_argument если размеры различаются
+     */
+    void requireSameSize(const BasicPolynomialArray& other) const {
+        if (other.count != count) {
+            throw std::invalid_argument("Razmery massivov polinomov ne sovpadayut");
+        }
+    }
+
+    /**
+     * @brief Выделяет выровненную по кэш-линии колонку
+     * @param n Количество элементов
+     * @return Указатель на неинициализированную память
+     */
+    Scalar* allocateColumn(std::size_t n) const {
+        return static_cast<Scalar*>(resource->allocate(n * sizeof(Scalar), alignment));
+    }
+    
+    /**
+     * @brief Освобождает колонку, выделенную allocateColumn()
+     * @param column Указатель на колонку (может быть nullptr)
+     * @param n Количество элементов, с которым колонка была выделена
+     */
+    void freeColumn(Scalar* column, std::size_t n) const {
+        if (column != nullptr) {
+            resource->deallocate(column, n * sizeof(Scalar), alignment);
+        }
+    }
+};
+
+/**
+ * @typedef PolynomialArray
+ * @brief Колоночное хранилище полиномов в double
+ */
+typedef BasicPolynomialArray<double> PolynomialArray;
+
+/**
+ * @typedef FloatPolynomialArray
+ * @brief Колоночное хранилище во float: вдвое меньше памяти и вдвое шире вектор
+ */
+typedef BasicPolynomialArray<float> FloatPolynomialArray;
+
+/**
+ * @typedef LongDoublePolynomialArray
+ * @brief Колоночное хранилище в long double (для проверки точности)
+ */
+typedef BasicPolynomialArray<long double> LongDoublePolynomialArray;
+
+/** @} */ // конец группы HelperStructures
+
+/**
+ * @defgroup Tabulation Табулирование на равномерной сетке
+ * @brief Вычисление значений полинома в точках x0, x0+h, x0+2h, ...
+ * @{
+ */
+
+/**
+ * @class PolynomialTabulator
+ * @brief Табулирование квадратного полинома конечными разностями
+ * 
+ * @details
+ * Для квадратного полинома вторая разность на равномерной сетке постоянна,
+ * поэтому после настройки каждое следующее значение получается двумя
+ * сложениями: p += d; d += d2. Чтобы сложения не образовывали одну длинную
+ * цепочку зависимостей, сетка обходится в lanes независимых дорожках: дорожка
+ * j хранит p(x0 + (i*lanes + j)*h) и разности с шагом lanes*h. Число дорожек
+ * не зависит от флагов сборки, поэтому результат одинаков на всех процессорах;
+ * вариант обхода выбирается по activeKernelIsa. С AVX-512 дорожки занимают
+ * четыре векторных регистра, и обход выдает 32 значения за четыре векторных
+ * сложения значений и четыре - разностей; с AVX2 дорожки обходятся двумя
+ * половинами по четыре регистра, чтобы значения и разности не вытеснялись
+ * из 16 регистров.
+ * 
+ * Ошибка округления в разностях накапливается с числом шагов, поэтому
+ * каждые resyncInterval точек значения и разности заново вычисляются из
+ * коэффициентов через evaluate() в точке x0 + i*h.
+ */
+class PolynomialTabulator {
+public:
+    static const std::size_t lanes = 32;                    ///< Количество независимых дорожек
+    static const std::size_t defaultResyncInterval = 4096;  ///< Период пересинхронизации по умолчанию
+    
+    /**
+     * @brief Конструктор
+     * @param p Табулируемый полином (коэффициенты копируются)
+     * @param x0 Первая точка сетки
+     * @param h Шаг сетки
+     * @param resyncInterval Количество точек между пересинхронизациями
+     * (округляется вверх до кратного lanes)
+     */
+    template <typename StatsPolicy>
+    PolynomialTabulator(const BasicPolynomial<StatsPolicy>& p, double x0, double h,
+                        std::size_t resyncInterval = defaultResyncInterval)
+        : polynomial(p.getA(), p.getB(), p.getC()), start(x0), step(h),
+          resyncRounds(std::max<std::size_t>(1, (resyncInterval + lanes - 1) / lanes)),
+          index(0), phase(0), roundsLeft(0), secondDelta(0.0) {
+        for (std::size_t j = 0; j < lanes; j++) {
+            value[j] = 0.0;
+            delta[j] = 0.0;
+        }
+    }
+    
+    /**
+     * @brief Возвращает номер следующей точки сетки
+     */
+    std::uint64_t position() const {
+        return index;
+    }
+    
+    /**
+     * @brief Переходит к точке сетки с номером i
+     * @param i Номер точки (x = x0 + i*h)
+     */
+    void seek(std::uint64_t i) {
+        index = i;
+        phase = 0;
+        roundsLeft = 0;
+    }
+    
+    /**
+     * @brief Вычисляет значения в следующих n точках сетки
+     * @param[out] out Буфер из n значений
+     * @param n Количество точек
+     */
+    void tabulate(double* out, std::size_t n) {
+        std::size_t k = 0;
+        while (k < n) {
+            if (phase == 0) {
+                if (roundsLeft == 0) {
+                    resync();
+                }
+                std::size_t rounds = std::min((n - k) / lanes, roundsLeft);
+                advanceRounds(out + k, rounds);
+                k += rounds * lanes;
+                roundsLeft -= rounds;
+                index += rounds * lanes;
+                if (k == n || roundsLeft == 0) {
+                    continue;
+                }
+            }
+            
+            // Неполный обход дорожек на границе буфера
+            out[k++] = value[phase++];
+            index++;
+            if (phase == lanes) {
+                advance();
+                phase = 0;
+                roundsLeft--;
+            }
+        }
+    }
+    
+    /**
+     * @brief Вычисляет значения в следующих count точках и передает их блоками
+     * @param count Количество точек
+     * @param sink Получатель блока: sink(const double* values, std::size_t n, std::uint64_t firstIndex)
+     * @param blockSize Количество значений в блоке
+     */
+    template <typename Sink>
+    void stream(std::uint64_t count, Sink&& sink, std::size_t blockSize = defaultResyncInterval) {
+        std::vector<double> buffer(static_cast<std::size_t>(std::min<std::uint64_t>(count, blockSize)));
+        while (count > 0) {
+            std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(count, buffer.size()));
+            std::uint64_t firstIndex = index;
+            tabulate(buffer.data(), n);
+            sink(static_cast<const double*>(buffer.data()), n, firstIndex);
+            count -= n;
+        }
+    }
+
+private:
+    PlainPolynomial polynomial;     ///< Коэффициенты табулируемого полинома
+    double start;                   ///< Первая точка сетки
+    double step;                    ///< Шаг сетки
+    std::size_t resyncRounds;       ///< Обходов дорожек между пересинхронизациями
+    std::uint64_t index;            ///< Номер следующей выдаваемой точки
+    std::size_t phase;              ///< Следующая дорожка в текущем обходе
+    std::size_t roundsLeft;         ///< Обходов до пересинхронизации
+    double value[lanes];            ///< Текущие значения дорожек
+    double delta[lanes];            ///< Первые разности дорожек
+    double secondDelta;             ///< Вторая разность (одинакова для всех дорожек)
+    
+    /**
+     * @brief Выдает rounds полных обходов дорожек
+     * @param[out] out Буфер из rounds*lanes значений
+     * @param rounds Количество обходов
+     * 
+     * @details Дорожки загружаются в регистры (локальные копии), так как
+     * запись в out иначе заставила бы перечитывать их из памяти
+     */
+    void advanceRounds(double* out, std::size_t rounds) {
+#if defined(POLY_KERNEL_DISPATCH)
+        switch (activeKernelIsa) {
+        case KernelIsa::avx512:
+            advanceRoundsAvx512(value, delta, secondDelta, out, rounds);
+            return;
+        case KernelIsa::avx2:
+            advanceRoundsAvx2(value, delta, secondDelta, out, rounds);
+            advanceRoundsAvx2(value + lanes / 2, delta + lanes / 2, secondDelta, out + lanes / 2, rounds);
+            return;
+        case KernelIsa::scalar:
+            break;
+        }
+#endif
+        const double second = secondDelta;
+        double v[lanes], d[lanes];
+        for (std::size_t j = 0; j < lanes; j++) {
+            v[j] = value[j];
+            d[j] = delta[j];
+        }
+        for (std::size_t r = 0; r < rounds; r++, out += lanes) {
+            for (std::size_t j = 0; j < lanes; j++) {
+                out[j] = v[j];
+                v[j] += d[j];
+                d[j] += second;
+            }
+        }
+        for (std::size_t j = 0; j < lanes; j++) {
+            value[j] = v[j];
+            delta[j] = d[j];
+        }
+    }
+    
+#if defined(POLY_KERNEL_DISPATCH)
+    /**
+     * @brief Вариант advanceRounds() для AVX-512: все 32 дорожки в четырех регистрах
+     */
+    POLY_TARGET_AVX512
+    static void advanceRoundsAvx512(double* value, double* delta, double secondDelta,
+                                    double* out, std::size_t rounds) {
+        const __m512d second = _mm512_set1_pd(secondDelta);
+        __m512d v0 = _mm512_loadu_pd(value), v1 = _mm512_loadu_pd(value + 8);
+        __m512d v2 = _mm512_loadu_pd(value + 16), v3 = _mm512_loadu_pd(value + 24);
+        __m512d d0 = _mm512_loadu_pd(delta), d1 = _mm512_loadu_pd(delta + 8);
+        __m512d d2 = _mm512_loadu_pd(delta + 16), d3 = _mm512_loadu_pd(delta + 24);
+        for (std::size_t r = 0; r < rounds; r++, out += lanes) {
+            _mm512_storeu_pd(out, v0);
+            _mm512_storeu_pd(out + 8, v1);
+            _mm512_storeu_pd(out + 16, v2);
+            _mm512_storeu_pd(out + 24, v3);
+            v0 = _mm512_add_pd(v0, d0);
+            v1 = _mm512_add_pd(v1, d1);
+            v2 = _mm512_add_pd(v2, d2);
+            v3 = _mm512_add_pd(v3, d3);
+            d0 = _mm512_add_pd(d0, second);
+            d1 = _mm512_add_pd(d1, second);
+            d2 = _mm512_add_pd(d2, second);
+            d3 = _mm512_add_pd(d3, second);
+        }
+        _mm512_storeu_pd(value, v0);
+        _mm512_storeu_pd(value + 8, v1);
+        _mm512_storeu_pd(value + 16, v2);
+        _mm512_storeu_pd(value + 24, v3);
+        _mm512_storeu_pd(delta, d0);
+        _mm512_storeu_pd(delta + 8, d1);
+        _mm512_storeu_pd(delta + 16, d2);
+        _mm512_storeu_pd(delta + 24, d3);
+    }
+    
+    /**
+     * @brief Вариант advanceRounds() для AVX2: половина дорожек (16) в четырех регистрах
+     * @details Вызывается дважды, для value и value + lanes/2; out сдвигается
+     * на lanes за обход, как и в остальных вариантах
+     */
+    POLY_TARGET_AVX2
+    static void advanceRoundsAvx2(double* value, double* delta, double secondDelta,
+                                  double* out, std::size_t rounds) {
+        const __m256d second = _mm256_set1_pd(secondDelta);
+        __m256d v0 = _mm256_loadu_pd(value), v1 = _mm256_loadu_pd(value + 4);
+        __m256d v2 = _mm256_loadu_pd(value + 8), v3 = _mm256_loadu_pd(value + 12);
+        __m256d d0 = _mm256_loadu_pd(delta), d1 = _mm256_loadu_pd(delta + 4);
+        __m256d d2 = _mm256_loadu_pd(delta + 8), d3 = _mm256_loadu_pd(delta + 12);
+        for (std::size_t r = 0; r < rounds; r++, out += lanes) {
+            _mm256_storeu_pd(out, v0);
+            _mm256_storeu_pd(out + 4, v1);
+            _mm256_storeu_pd(out + 8, v2);
+            _mm256_storeu_pd(out + 12, v3);
+            v0 = _mm256_add_pd(v0, d0);
+            v1 = _mm256_add_pd(v1, d1);
+            v2 = _mm256_add_pd(v2, d2);
+            v3 = _mm256_add_pd(v3, d3);
+            d0 = _mm256_add_pd(d0, second);
+            d1 = _mm256_add_pd(d1, second);
+            d2 = _mm256_add_pd(d2, second);
+            d3 = _mm256_add_pd(d3, second);
+        }
+        _mm256_storeu_pd(value, v0);
+        _mm256_storeu_pd(value + 4, v1);
+        _mm256_storeu_pd(value + 8, v2);
+        _mm256_storeu_pd(value + 12, v3);
+        _mm256_storeu_pd(delta, d0);
+        _mm256_storeu_pd(delta + 4, d1);
+        _mm256_storeu_pd(delta + 8, d2);
+        _mm256_storeu_pd(delta + 12, d3);
+    }
+#endif
+    
+    /**
+     * @brief Сдвигает все дорожки на lanes точек вперед
+     */
+    void advance() {
+        for (std::size_t j = 0; j < lanes; j++) {
+            value[j] += delta[j];
+            delta[j] += secondDelta;
+        }
+    }
+    
+    /**
+     * @brief Заново вычисляет значения и разности дорожек от точки index
+     * @details p(x + H) - p(x) = a*(2xH + H²) + b*H, вторая разность 2aH²
+     */
+    void resync() {
+        const double a = polynomial.getA();
+        const double b = polynomial.getB();
+        const double stride = step * static_cast<double>(lanes);
+        for (std::size_t j = 0; j < lanes; j++) {
+            double x = start + static_cast<double>(index + j) * step;
+            value[j] = polynomial.evaluate(x);
+            delta[j] = a * (2.0 * x * stride + stride * stride) + b * stride;
+        }
+        secondDelta = 2.0 * a * stride * stride;
+        roundsLeft = resyncRounds;
+    }
+};
+
+/** @} */ // конец группы Tabulation
+
+/**
+ * @defgroup Ordering Упорядочивание полиномов
+ * @brief Сортировка и упорядоченный индекс по ключу сравнения
+ * 
+ * @details
+ * Операторы сравнения вычисляют evaluate(2) для обеих сторон при каждом
+ * вызове. Здесь ключ comparisonKey() вычисляется один раз на элемент,
+ * переводится в целое, порядок которого совпадает с порядком чисел, и пары
+ * (ключ, индекс) сортируются поразрядно за O(N).
+ * @{
+ */
+
+/**
+ * @struct KeyedIndex
+ * @brief Ключ сравнения элемента и его индекс в массиве
+ */
+struct KeyedIndex {
+    std::uint64_t key;  ///< Ключ в виде упорядоченного целого (см. orderedKeyBits())
+    std::size_t index;  ///< Индекс элемента
+};
+
+/**
+ * @brief Переводит double в целое с тем же порядком
+ * @param key Значение ключа
+ * @return Целое, для которого беззнаковое сравнение совпадает со сравнением чисел
+ * 
+ * @details -0.0 приводится к +0.0, так как операторы сравнения их не
+ * различают. NaN с нулевым знаковым битом оказываются после +inf, с
+ * единичным - перед -inf.
+ */
+inline std::uint64_t orderedKeyBits(double key) {
+    if (key == 0.0) {
+        key = 0.0;
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return (bits >> 63) ? ~bits : (bits | (std::uint64_t(1) << 63));
+}
+
+/**
+ * @brief Устойчиво сортирует пары (ключ, индекс) по ключу
+ * @param items Сортируемые пары
+ * 
+ * @details
+ * Поразрядная сортировка LSD по 11 бит за проход (6 проходов). Гистограммы
+ * всех разрядов строятся одним чтением массива; проходы, в которых все
+ * ключи попадают в один карман (например, старшие разряды близких чисел),
+ * пропускаются. Небольшие массивы сортируются std::stable_sort.
+ */
+void radixSortKeys(std::vector<KeyedIndex>& items) {
+    const std::size_t n = items.size();
+    if (n < 256) {
+        std::stable_sort(items.begin(), items.end(),
+                         [](const KeyedIndex& x, const KeyedIndex& y) { return x.key < y.key; });
+        return;
+    }
+    
+    const unsigned digitBits = 11;
+    const std::size_t buckets = std::size_t(1) << digitBits;
+    const unsigned passes = (64 + digitBits - 1) / digitBits;
+    std::vector<std::size_t> histogram(passes * buckets, 0);
+    for (const KeyedIndex& item : items) {
+        for (unsigned pass = 0; pass < passes; pass++) {
+            histogram[pass * buckets + ((item.key >> (pass * digitBits)) & (buckets - 1))]++;
+        }
+    }
+    
+    std::vector<KeyedIndex> buffer(n);
+    KeyedIndex* source = items.data();
+    KeyedIndex* target = buffer.data();
+    for (unsigned pass = 0; pass < passes; pass++) {
+        std::size_t* counts = histogram.data() + pass * buckets;
+        unsigned shift = pass * digitBits;
+        if (counts[(source[0].key >> shift) & (buckets - 1)] == n) {
+            continue;
+        }
+        
+        std::size_t offset = 0;
+        for (std::size_t d = 0; d < buckets; d++) {
+            std::size_t bucketSize = counts[d];
+            counts[d] = offset;
+            offset += bucketSize;
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            target[counts[(source[i].key >> shift) & (buckets - 1)]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+    if (source != items.data()) {
+        std::memcpy(items.data(), source, n * sizeof(KeyedIndex));
+    }
+}
+
+/**
+ * @brief Вычисляет порядок полиномов по возрастанию ключа сравнения
+ * @param polynomials Колонки коэффициентов
+ * @param[out] items Пары (ключ, индекс) в порядке возрастания ключа;
+ * равные элементы сохраняют исходный порядок
+ */
+void sortedOrder(const CoefficientSpan& polynomials, std::vector<KeyedIndex>& items) {
+    items.resize(polynomials.count);
+    for (std::size_t i = 0; i < polynomials.count; i++) {
+        PlainPolynomial p(polynomials.a[i], polynomials.b[i], polynomials.c[i]);
+        items[i].key = orderedKeyBits(p.comparisonKey());
+        items[i].index = i;
+    }
+    radixSortKeys(items);
+}
+
+/**
+ * @brief Сортирует массив полиномов по возрастанию (в смысле operator<)
+ * @param polynomials Массив полиномов
+ * 
+ * @details Результат совпадает с std::stable_sort по operator< для
+ * массивов без NaN в ключах; ключ вычисляется один раз на элемент
+ */
+void sortPolynomials(PolynomialArray& polynomials) {
+    std::vector<KeyedIndex> items;
+    sortedOrder(polynomials.span(), items);
+    std::vector<std::size_t> order(items.size());
+    for (std::size_t i = 0; i < items.size(); i++) {
+        order[i] = items[i].index;
+    }
+    polynomials.permute(order.data());
+}
+
+/**
+ * @class PolynomialOrderedIndex
+ * @brief Упорядоченный индекс массива полиномов по ключу сравнения
+ * 
+ * @details
+ * Хранит отсортированные ключи отдельно от индексов, чтобы двоичный поиск
+ * читал только плотный массив ключей. Запрос диапазона [lo, hi] - два
+ * двоичных поиска и последовательный обход найденного участка, O(log N + k).
+ * Индекс не отслеживает изменения массива: после изменения его нужно
+ * построить заново через build().
+ */
+class PolynomialOrderedIndex {
+public:
+    /**
+     * @brief Конструктор пустого индекса
+     */
+    PolynomialOrderedIndex() {}
+    
+    /**
+     * @brief Строит индекс по колонкам коэффициентов
+     * @param polynomials Колонки коэффициентов
+     */
+    explicit PolynomialOrderedIndex(const CoefficientSpan& polynomials) {
+        build(polynomials);
+    }
+    
+    /**
+     * @brief Перестраивает индекс
+     * @param polynomials Колонки коэффициентов
+     */
+    void build(const CoefficientSpan& polynomials) {
+        std::vector<KeyedIndex> items;
+        sortedOrder(polynomials, items);
+        keys.resize(items.size());
+        indices.resize(items.size());
+        for (std::size_t i = 0; i < items.size(); i++) {
+            keys[i] = items[i].key;
+            indices[i] = items[i].index;
+        }
+    }
+    
+    /**
+     * @brief Возвращает количество элементов в индексе
+     */
+    std::size_t size() const {
+        return keys.size();
+    }
+    
+    /**
+     * @brief Возвращает индекс элемента, стоящего на позиции rank в порядке возрастания
+     */
+    std::size_t indexAt(std::size_t rank) const {
+        return indices[rank];
+    }
+    
+    /**
+     * @brief Находит участок позиций с ключом в [lo, hi]
+     * @param lo Нижняя граница ключа (включительно)
+     * @param hi Верхняя граница ключа (включительно)
+     * @param[out] first Первая позиция участка
+     * @param[out] last Позиция за последней позицией участка
+     * @note При lo > hi или NaN в границах участок пуст
+     */
+    void rangeBounds(double lo, double hi, std::size_t& first, std::size_t& last) const {
+        first = last = 0;
+        if (!(lo <= hi)) {
+            return;
+        }
+        std::uint64_t loBits = orderedKeyBits(lo);
+        std::uint64_t hiBits = orderedKeyBits(hi);
+        first = static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), loBits) - keys.begin());
+        last = static_cast<std::size_t>(std::upper_bound(keys.begin() + first, keys.end(), hiBits) - keys.begin());
+    }
+    
+    /**
+     * @brief Вызывает visitor(index) для всех полиномов с p(2) в [lo, hi]
+     * @param lo Нижняя граница ключа (включительно)
+     * @param hi Верхняя граница ключа (включительно)
+     * @param visitor Функция, получающая индекс элемента массива
+     * @details Элементы перечисляются в порядке возрастания ключа
+     */
+    template <typename Visitor>
+    void forEachInRange(double lo, double hi, Visitor&& visitor) const {
+        std::size_t first, last;
+        rangeBounds(lo, hi, first, last);
+        for (std::size_t rank = first; rank < last; rank++) {
+            visitor(indices[rank]);
+        }
+    }
+    
+    /**
+     * @brief Собирает индексы полиномов с p(2) в [lo, hi]
+     * @param lo Нижняя граница ключа (включительно)
+     * @param hi Верхняя граница ключа (включительно)
+     * @param[out] out Индексы в порядке возрастания ключа (дописываются в конец)
+     * @return Количество найденных полиномов
+     */
+    std::size_t range(double lo, double hi, std::vector<std::size_t>& out) const {
+        std::size_t first, last;
+        rangeBounds(lo, hi, first, last);
+        out.insert(out.end(), indices.begin() + first, indices.begin() + last);
+        return last - first;
+    }
+
+private:
+    std::vector<std::uint64_t> keys;    ///< Ключи в порядке возрастания (см. orderedKeyBits())
+    std::vector<std::size_t> indices;   ///< Индексы элементов в том же порядке
+};
+
+/** @} */ // конец группы Ordering
+
+/**
+ * @defgroup RootCaching Кэширование корней
+ * @brief Запоминание результатов findRoots() для повторяющихся коэффициентов
+ * @{
+ */
+
+/**
+ * @class RootCache
+ * @brief Ограниченный потокобезопасный кэш корней по точным значениям коэффициентов
+ * 
+ * @details
+ * Ключ - битовое представление тройки (a, b, c), поэтому 0.0 и -0.0 дают
+ * разные ключи, а NaN с одинаковыми битами - одинаковые. Кэш разбит на
+ * шарды со своими мьютексами; шард и множество внутри него выбираются по
+ * хешу ключа. Множество из ways записей вытесняет записи по алгоритму CLOCK:
+ * стрелка пропускает записи с битом обращения, сбрасывая его, и вытесняет
+ * первую запись без него.
+ * 
+ * Обращения учитываются политикой статистики полинома (onRootCacheLookup())
+ * и выводятся вместе со статистикой вычисления корней; попадание не
+ * считается вычислением корней.
+ */
+class RootCache {
+public:
+    static const std::size_t ways = 4; ///< Записей в множестве
+    
+    /**
+     * @brief Конструктор
+     * @param capacity Наибольшее количество записей (округляется вверх до
+     * степени двойки на шард)
+     * @param shardCount Количество шардов (округляется вверх до степени двойки)
+     */
+    explicit RootCache(std::size_t capacity = 65536, unsigned shardCount = 16)
+        : shardBits(0), setMask(0) {
+        while ((1u << shardBits) < shardCount) {
+            shardBits++;
+        }
+        std::size_t sets = 1;
+        while (sets * ways * (std::size_t(1) << shardBits) < capacity) {
+            sets *= 2;
+        }
+        setMask = sets - 1;
+        
+        shards = new Shard[std::size_t(1) << shardBits];
+        for (std::size_t i = 0; i < shardCountValue(); i++) {
+            shards[i].entries = new Entry[sets * ways]();
+            shards[i].hands = new unsigned char[sets]();
+        }
+    }
+    
+    RootCache(const RootCache&) = delete;
+    RootCache& operator=(const RootCache&) = delete;
+    
+    ~RootCache() {
+        for (std::size_t i = 0; i < shardCountValue(); i++) {
+            delete[] shards[i].entries;
+            delete[] shards[i].hands;
+        }
+        delete[] shards;
+    }
+    
+    /**
+     * @brief Возвращает наибольшее количество записей
+     */
+    std::size_t capacity() const {
+        return shardCountValue() * (setMask + 1) * ways;
+    }
+    
+    /**
+     * @brief Находит корни полинома, используя кэш
+     * @param p Полином
+     * @param[out] root1 Первый корень (не изменяется, если корней нет)
+     * @param[out] root2 Второй корень (не изменяется, если корней меньше двух)
+     * @param[out] numRoots Количество корней
+     * @return true, если результат взят из кэша
+     * 
+     * @details При промахе вызывается p.findRoots(), которая учитывает
+     * вычисление в статистике своей политики; попадание учитывается только
+     * как попадание в кэш.
+     */
+    template <typename StatsPolicy>
+    bool findRoots(BasicPolynomial<StatsPolicy>& p, double& root1, double& root2, int& numRoots) {
+        bool hit = lookup(p.getA(), p.getB(), p.getC(), root1, root2, numRoots);
+        StatsPolicy::onRootCacheLookup(hit);
+        if (!hit) {
+            p.findRoots(root1, root2, numRoots);
+            insert(p.getA(), p.getB(), p.getC(), root1, root2, numRoots);
+        }
+        return hit;
+    }
+    
+    /**
+     * @brief Ищет результат для коэффициентов
+     * @return true, если результат найден; корни записываются так же, как findRoots()
+     */
+    bool lookup(double a, double b, double c, double& root1, double& root2, int& numRoots) {
+        Key key = makeKey(a, b, c);
+        std::uint64_t hash = hashKey(key);
+        Shard& shard = shards[shardIndex(hash)];
+        Entry* set = shard.entries + (hash & setMask) * ways;
+        
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (std::size_t way = 0; way < ways; way++) {
+            Entry& entry = set[way];
+            if (entry.valid && entry.a == key.a && entry.b == key.b && entry.c == key.c) {
+                entry.referenced = true;
+                numRoots = entry.numRoots;
+                if (numRoots >= 1) {
+                    root1 = entry.root1;
+                }
+                if (numRoots >= 2) {
+                    root2 = entry.root2;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * @brief Сохраняет результат для коэффициентов
+     * @param root1 Первый корень (учитывается при numRoots >= 1)
+     * @param root2 Второй корень (учитывается при numRoots >= 2)
+     */
+    void insert(double a, double b, double c, double root1, double root2, int numRoots) {
+        Key key = makeKey(a, b, c);
+        std::uint64_t hash = hashKey(key);
+        Shard& shard = shards[shardIndex(hash)];
+        std::size_t setIndex = hash & setMask;
+        Entry* set = shard.entries + setIndex * ways;
+        
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Entry* victim = nullptr;
+        for (std::size_t way = 0; way < ways && victim == nullptr; way++) {
+            Entry& entry = set[way];
+            if (!entry.valid || (entry.a == key.a && entry.b == key.b && entry.c == key.c)) {
+                victim = &entry;
+            }
+        }
+        
+        unsigned char& hand = shard.hands[setIndex];
+        while (victim == nullptr) {
+            Entry& entry = set[hand];
+            hand = static_cast<unsigned char>((hand + 1) % ways);
+            if (entry.referenced) {
+                entry.referenced = false;
+            } else {
+                victim = &entry;
+            }
+        }
+        
+        victim->a = key.a;
+        victim->b = key.b;
+        victim->c = key.c;
+        victim->root1 = root1;
+        victim->root2 = root2;
+        victim->numRoots = numRoots;
+        victim->valid = true;
+        victim->referenced = false;
+    }
+    
+    /**
+     * @brief Удаляет все записи
+     */
+    void clear() {
+        for (std::size_t i = 0; i < shardCountValue(); i++) {
+            std::lock_guard<std::mutex> lock(shards[i].mutex);
+            std::fill(shards[i].entries, shards[i].entries + (setMask + 1) * ways, Entry());
+            std::fill(shards[i].hands, shards[i].hands + setMask + 1, 0);
+        }
+    }
+
+private:
+    /**
+     * @struct Key
+     * @brief Битовое представление коэффициентов
+     */
+    struct Key {
+        std::uint64_t a, b, c;
+    };
+    
+    /**
+     * @struct Entry
+     * @brief Запись кэша
+     */
+    struct Entry {
+        std::uint64_t a, b, c;  ///< Ключ
+        double root1, root2;    ///< Корни
+        int numRoots;           ///< Количество корней
+        bool valid;             ///< Запись занята
+        bool referenced;        ///< Бит обращения для CLOCK
+    };
+    
+    /**
+     * @struct Shard
+     * @brief Часть кэша со своим мьютексом
+     */
+    struct alignas(64) Shard {
+        std::mutex mutex;               ///< Защищает записи и стрелки шарда
+        Entry* entries = nullptr;       ///< Множества по ways записей
+        unsigned char* hands = nullptr; ///< Стрелки CLOCK множеств
+    };
+    
+    Shard* shards;          ///< Шарды
+    unsigned shardBits;     ///< log2 количества шардов
+    std::size_t setMask;    ///< Количество множеств в шарде минус один
+    
+    std::size_t shardCountValue() const {
+        return std::size_t(1) << shardBits;
+    }
+    
+    std::size_t shardIndex(std::uint64_t hash) const {
+        return shardBits == 0 ? 0 : static_cast<std::size_t>(hash >> (64 - shardBits));
+    }
+    
+    static Key makeKey(double a, double b, double c) {
+        Key key;
+        std::memcpy(&key.a, &a, sizeof(double));
+        std::memcpy(&key.b, &b, sizeof(double));
+        std::memcpy(&key.c, &c, sizeof(double));
+        return key;
+    }
+    
+    static std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+    
+    static std::uint64_t hashKey(const Key& key) {
+        return mix(key.a ^ mix(key.b ^ mix(key.c)));
+    }
+};
+
+/** @} */ // конец группы RootCaching
+
+/**
+ * @defgroup ExpressionTemplates Шаблоны выражений
+ * @brief Вычисление арифметических выражений над полиномами за один проход
+ * 
+ * @details
+ * Операнды, обернутые в expr(), образуют дерево выражения вместо
+ * промежуточных полиномов: expr(p1) + expr(p2) - 3.0 * expr(p3) не создает
+ * ни одного объекта BasicPolynomial, пока выражение не присвоено полиному
+ * (конструктором или operator=). Каждый коэффициент результата вычисляется
+ * теми же операциями, что и в обычных операторах, поэтому результат
+ * совпадает с результатом цепочки временных объектов.
+ * 
+ * Если в выражении участвует массив (expr(PolynomialArray) или
+ * expr(CoefficientSpan)), выражение поэлементное: assign() записывает его в
+ * PolynomialArray одним проходом без выделения памяти (кроме роста
+ * приемника), одиночные полиномы при этом применяются к каждому элементу.
+ * @warning Выражение хранит ссылки на операнды и должно использоваться в
+ * пределах их времени жизни
+ * @{
+ */
+
+/**
+ * @brief Размер выражения без массивов (применяется к любому количеству элементов)
+ */
+const std::size_t broadcastSize = static_cast<std::size_t>(-1);
+
+/**
+ * @struct PolynomialExpression
+ * @brief Базовый класс (CRTP) узлов выражения
+ * @tparam Derived Тип узла; узел предоставляет a(i), b(i), c(i), size() и
+ * константу elementwise
+ */
+template <typename Derived>
+struct PolynomialExpression {
+    /**
+     * @brief Возвращает узел как объект производного типа
+     */
+    const Derived& self() const {
+        return static_cast<const Derived&>(*this);
+    }
+};
+
+/**
+ * @brief Объединяет размеры операндов бинарного узла
+ * @throws std::invalid_argument если размеры массивов не совпадают
+ */
+inline std::size_t combinedExpressionSize(std::size_t left, std::size_t right) {
+    if (left == broadcastSize) {
+        return right;
+    }
+    if (right != broadcastSize && right != left) {
+        throw std::invalid_argument("Razmery massivov v vyrazhenii ne sovpadayut");
+    }
+    return left;
+}
+
+/**
+ * @class PolynomialTerm
+ * @brief Лист выражения: один полином
+ */
+template <typename Poly>
+class PolynomialTerm : public PolynomialExpression<PolynomialTerm<Poly> > {
+public:
+    static constexpr bool elementwise = false; ///< Содержит ли выражение массивы
+    
+    explicit PolynomialTerm(const Poly& p) : polynomial(p) {}
+    
+    double a(std::size_t) const { return polynomial.getA(); }
+    double b(std::size_t) const { return polynomial.getB(); }
+    double c(std::size_t) const { return polynomial.getC(); }
+    std::size_t size() const { return broadcastSize; }
+
+private:
+    const Poly& polynomial; ///< Операнд
+};
+
+/**
+ * @class CoefficientColumnsTerm
+ * @brief Лист выражения: колонки коэффициентов массива полиномов
+ */
+class CoefficientColumnsTerm : public PolynomialExpression<CoefficientColumnsTerm> {
+public:
+    static constexpr bool elementwise = true; ///< Содержит ли выражение массивы
+    
+    explicit CoefficientColumnsTerm(const CoefficientSpan& columns) : span(columns) {}
+    
+    double a(std::size_t i) const { return span.a[i]; }
+    double b(std::size_t i) const { return span.b[i]; }
+    double c(std::size_t i) const { return span.c[i]; }
+    std::size_t size() const { return span.count; }
+
+private:
+    CoefficientSpan span; ///< Операнд
+};
+
+/**
+ * @struct ExpressionAdd
+ * @brief Операция сложения коэффициентов
+ */
+struct ExpressionAdd {
+    static double apply(double x, double y) { return x + y; }
+};
+
+/**
+ * @struct ExpressionSubtract
+ * @brief Операция вычитания коэффициентов
+ */
+struct ExpressionSubtract {
+    static double apply(double x, double y) { return x - y; }
+};
+
+/**
+ * @struct ExpressionMultiply
+ * @brief Умножение коэффициента на скаляр
+ */
+struct ExpressionMultiply {
+    static double apply(double x, double scalar) { return x * scalar; }
+};
+
+/**
+ * @struct ExpressionDivide
+ * @brief Деление коэффициента на скаляр
+ */
+struct ExpressionDivide {
+    static double apply(double x, double scalar) { return x / scalar; }
+};
+
+/**
+ * @class PolynomialBinaryExpression
+ * @brief Узел выражения: покоэффициентная операция над двумя выражениями
+ */
+template <typename Left, typename Right, typename Op>
+class PolynomialBinaryExpression : public PolynomialExpression<PolynomialBinaryExpression<Left, Right, Op> > {
+public:
+    static constexpr bool elementwise = Left::elementwise || Right::elementwise; ///< Содержит ли выражение массивы
+    
+    PolynomialBinaryExpression(const Left& l, const Right& r) : left(l), right(r) {}
+    
+    double a(std::size_t i) const { return Op::apply(left.a(i), right.a(i)); }
+    double b(std::size_t i) const { return Op::apply(left.b(i), right.b(i)); }
+    double c(std::size_t i) const { return Op::apply(left.c(i), right.c(i)); }
+    std::size_t size() const { return combinedExpressionSize(left.size(), right.size()); }
+
+private:
+    Left left;      ///< Левый операнд
+    Right right;    ///< Правый операнд
+};
+
+/**
+ * @class PolynomialScalarExpression
+ * @brief Узел выражения: операция над выражением и скаляром
+ */
+template <typename Operand, typename Op>
+class PolynomialScalarExpression : public PolynomialExpression<PolynomialScalarExpression<Operand, Op> > {
+public:
+    static constexpr bool elementwise = Operand::elementwise; ///< Содержит ли выражение массивы
+    
+    PolynomialScalarExpression(const Operand& e, double s) : operand(e), scalar(s) {}
+    
+    double a(std::size_t i) const { return Op::apply(operand.a(i), scalar); }
+    double b(std::size_t i) const { return Op::apply(operand.b(i), scalar); }
+    double c(std::size_t i) const { return Op::apply(operand.c(i), scalar); }
+    std::size_t size() const { return operand.size(); }
+
+private:
+    Operand operand;    ///< Выражение
+    double scalar;      ///< Скаляр
+};
+
+/**
+ * @brief Делает полином операндом выражения
+ */
+template <typename StatsPolicy>
+PolynomialTerm<BasicPolynomial<StatsPolicy> > expr(const BasicPolynomial<StatsPolicy>& p) {
+    return PolynomialTerm<BasicPolynomial<StatsPolicy> >(p);
+}
+
+/**
+ * @brief Делает колонки коэффициентов поэлементным операндом выражения
+ */
+inline CoefficientColumnsTerm expr(const CoefficientSpan& columns) {
+    return CoefficientColumnsTerm(columns);
+}
+
+/**
+ * @brief Делает массив полиномов поэлементным операндом выражения
+ */
+inline CoefficientColumnsTerm expr(const PolynomialArray& polynomials) {
+    return CoefficientColumnsTerm(polynomials.span());
+}
+
+template <typename Left, typename Right>
+PolynomialBinaryExpression<Left, Right, ExpressionAdd>
+operator+(const PolynomialExpression<Left>& left, const PolynomialExpression<Right>& right) {
+    return PolynomialBinaryExpression<Left, Right, ExpressionAdd>(left.self(), right.self());
+}
+
+template <typename Left, typename Right>
+PolynomialBinaryExpression<Left, Right, ExpressionSubtract>
+operator-(const PolynomialExpression<Left>& left, const PolynomialExpression<Right>& right) {
+    return PolynomialBinaryExpression<Left, Right, ExpressionSubtract>(left.self(), right.self());
+}
+
+template <typename Operand>
+PolynomialScalarExpression<Operand, ExpressionMultiply>
+operator*(const PolynomialExpression<Operand>& operand, double scalar) {
+    return PolynomialScalarExpression<Operand, ExpressionMultiply>(operand.self(), scalar);
+}
+
+template <typename Operand>
+PolynomialScalarExpression<Operand, ExpressionMultiply>
+operator*(double scalar, const PolynomialExpression<Operand>& operand) {
+    return PolynomialScalarExpression<Operand, ExpressionMultiply>(operand.self(), scalar);
+}
+
+/**
+ * @throws std::invalid_argument если scalar = 0, как и BasicPolynomial::operator/=
+ */
+template <typename Operand>
+PolynomialScalarExpression<Operand, ExpressionDivide>
+operator/(const PolynomialExpression<Operand>& operand, double scalar) {
+    if (scalar == 0) {
+        throw std::invalid_argument("Delenie na nol!");
+    }
+    return PolynomialScalarExpression<Operand, ExpressionDivide>(operand.self(), scalar);
+}
+
+/**
+ * @brief Вычисляет блок одной колонки поэлементного выражения
+ * @tparam Column Колонка: 0 - a, 1 - b, 2 - c
+ * @param e Выражение
+ * @param begin Первый элемент блока
+ * @param count Размер блока (не больше expressionBlockSize)
+ * @param[out] out Колонка приемника, начиная с элемента begin
+ * 
+ * @details Значения сначала пишутся в локальный буфер: запись в него не
+ * пересекается с операндами, поэтому цикл векторизуется без проверок
+ * перекрытия. Полные блоки обходятся циклом с постоянным числом итераций.
+ */
+const std::size_t expressionBlockSize = 256; ///< Размер блока поэлементного вычисления
+
+template <int Column, typename Expression>
+void evaluateExpressionColumn(const Expression& e, std::size_t begin, std::size_t count, double* out) {
+    auto coefficient = [&e](std::size_t i) {
+        if constexpr (Column == 0) {
+            return e.a(i);
+        } else if constexpr (Column == 1) {
+            return e.b(i);
+        } else {
+            return e.c(i);
+        }
+    };
+    
+    double block[expressionBlockSize];
+    if (count == expressionBlockSize) {
+        for (std::size_t i = 0; i < expressionBlockSize; i++) {
+            block[i] = coefficient(begin + i);
+        }
+    } else {
+        for (std::size_t i = 0; i < count; i++) {
+            block[i] = coefficient(begin + i);
+        }
+    }
+    std::memcpy(out, block, count * sizeof(double));
+}
+
+/**
+ * @brief Записывает поэлементное выражение в массив полиномов
+ * @param destination Приемник; может быть операндом выражения
+ * @param expression Выражение, содержащее хотя бы один массив
+ * @throws std::invalid_argument если размеры массивов выражения не совпадают
+ * 
+ * @details
+ * Элемент i каждой колонки результата зависит только от i-х элементов той же
+ * колонки операндов, поэтому приемник может совпадать с операндом.
+ */
+template <typename Expression>
+void assign(PolynomialArray& destination, const PolynomialExpression<Expression>& expression) {
+    static_assert(Expression::elementwise, "Vyrazhenie dolzhno soderzhat massiv (expr(PolynomialArray))");
+    const Expression& e = expression.self();
+    const std::size_t n = e.size();
+    if (n > destination.capacity) {
+        destination.reserve(n);
+    }
+    
+    for (std::size_t begin = 0; begin < n; begin += expressionBlockSize) {
+        std::size_t count = std::min(expressionBlockSize, n - begin);
+        evaluateExpressionColumn<0>(e, begin, count, destination.a + begin);
+        evaluateExpressionColumn<1>(e, begin, count, destination.b + begin);
+        evaluateExpressionColumn<2>(e, begin, count, destination.c + begin);
+    }
+    destination.count = n;
+}
+
+/** @} */ // конец группы ExpressionTemplates
+
+/**
+ * @defgroup ParallelProcessing Параллельная обработка
+ * @brief Многопоточная обработка массивов полиномов
+ * @{
+ */
+
+/**
+ * @class WorkStealingPool
+ * @brief Пул потоков с перехватом работы (work stealing) для диапазонов индексов
+ * 
+ * @details
+ * Диапазон [0, count) делится на порции по chunkSize элементов, и порции
+ * поровну раздаются потокам. Каждый поток забирает порции из начала своей
+ * очереди, а закончив, перехватывает половину оставшихся порций из конца
+ * очереди другого потока. Очередь потока — одно 64-битное атомарное слово
+ * с границами [begin, end) в номерах порций, поэтому и взятие, и перехват
+ * выполняются одной операцией compare-exchange. Вызывающий поток участвует
+ * в работе наравне с потоками пула.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Конструктор
+     * @param threadCount Количество потоков, включая вызывающий
+     * (0 - по числу аппаратных потоков)
+     */
+    explicit WorkStealingPool(unsigned threadCount = 0)
+        : workerCount(threadCount != 0 ? threadCount : std::thread::hardware_concurrency()),
+          queues(nullptr), threads(nullptr), generation(0), stopping(false), busyWorkers(0),
+          jobInvoke(nullptr), jobContext(nullptr), jobCount(0), jobChunkSize(1) {
+        if (workerCount == 0) {
+            workerCount = 1;
+        }
+        queues = new WorkerQueue[workerCount];
+        threads = new std::thread[workerCount - 1];
+        for (unsigned i = 1; i < workerCount; i++) {
+            threads[i - 1] = std::thread(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+    
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    
+    /**
+     * @brief Деструктор
+     * @post Останавливает и присоединяет все потоки пула
+     */
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        wakeWorkers.notify_all();
+        for (unsigned i = 1; i < workerCount; i++) {
+            threads[i - 1].join();
+        }
+        delete[] threads;
+        delete[] queues;
+    }
+    
+    /**
+     * @brief Возвращает количество потоков, включая вызывающий
+     */
+    unsigned size() const {
+        return workerCount;
+    }
+    
+    /**
+     * @brief Выполняет body(begin, end) для всех порций диапазона [0, count)
+     * @param count Размер диапазона
+     * @param chunkSize Размер порции
+     * @param body Функция обработки полуинтервала индексов
+     * @post Возвращает управление, когда обработаны все порции
+     * @note Одновременные вызовы из разных потоков выполняются по очереди
+     */
+    template <typename Body>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Body& body) {
+        run(count, chunkSize, &invokeBody<Body>, &body);
+    }
+
+private:
+    /**
+     * @struct WorkerQueue
+     * @brief Очередь порций одного потока: старшие 32 бита - begin, младшие - end
+     */
+    struct alignas(64) WorkerQueue {
+        std::atomic<std::uint64_t> range{0};
+    };
+    
+    unsigned workerCount;           ///< Количество потоков, включая вызывающий
+    WorkerQueue* queues;            ///< Очереди порций потоков
+    std::thread* threads;           ///< Потоки пула (workerCount - 1)
+    
+    std::mutex jobMutex;            ///< Упорядочивает одновременные вызовы parallelFor()
+    std::mutex stateMutex;          ///< Защищает состояние задания
+    std::condition_variable wakeWorkers;  ///< Пробуждает потоки при новом задании
+    std::condition_variable jobDone;      ///< Сообщает о завершении потоков пула
+    std::uint64_t generation;       ///< Номер текущего задания
+    bool stopping;                  ///< Флаг остановки пула
+    unsigned busyWorkers;           ///< Потоки пула, еще работающие над заданием
+    
+    void (*jobInvoke)(void*, std::size_t, std::size_t); ///< Обработчик порции
+    void* jobContext;               ///< Контекст обработчика
+    std::size_t jobCount;           ///< Размер диапазона задания
+    std::size_t jobChunkSize;       ///< Размер порции задания
+    
+    template <typename Body>
+    static void invokeBody(void* context, std::size_t begin, std::size_t end) {
+        (*static_cast<Body*>(context))(begin, end);
+    }
+    
+    static std::uint64_t pack(std::uint64_t begin, std::uint64_t end) {
+        return (begin << 32) | end;
+    }
+    
+    /**
+     * @brief Раздает порции и выполняет задание
+     */
+    void run(std::size_t count, std::size_t chunkSize,
+             void (*invoke)(void*, std::size_t, std::size_t), void* context) {
+        if (count == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> jobLock(jobMutex);
+        
+        // Номер порции должен помещаться в 32 бита
+        const std::size_t maxChunks = 0xFFFFFFFFu;
+        if (chunkSize == 0) {
+            chunkSize = 1;
+        }
+        if ((count + chunkSize - 1) / chunkSize > maxChunks) {
+            chunkSize = (count + maxChunks - 1) / maxChunks;
+        }
+        std::uint64_t chunks = (count + chunkSize - 1) / chunkSize;
+        
+        for (unsigned w = 0; w < workerCount; w++) {
+            std::uint64_t begin = chunks * w / workerCount;
+            std::uint64_t end = chunks * (w + 1) / workerCount;
+            queues[w].range.store(pack(begin, end), std::memory_order_relaxed);
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            jobInvoke = invoke;
+            jobContext = context;
+            jobCount = count;
+            jobChunkSize = chunkSize;
+            busyWorkers = workerCount - 1;
+            ++generation;
+        }
+        wakeWorkers.notify_all();
+        
+        processChunks(0);
+        
+        std::unique_lock<std::mutex> lock(stateMutex);
+        jobDone.wait(lock, [this] { return busyWorkers == 0; });
+    }
+    
+    /**
+     * @brief Цикл потока пула: ожидание задания и его выполнение
+     */
+    void workerLoop(unsigned index) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                wakeWorkers.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            
+            processChunks(index);
+            
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (--busyWorkers == 0) {
+                jobDone.notify_one();
+            }
+        }
+    }
+    
+    /**
+     * @brief Обрабатывает свои порции, затем перехватывает чужие
+     */
+    void processChunks(unsigned index) {
+        std::uint64_t chunk;
+        do {
+            while (popChunk(index, chunk)) {
+                std::size_t begin = static_cast<std::size_t>(chunk) * jobChunkSize;
+                std::size_t end = begin + jobChunkSize < jobCount ? begin + jobChunkSize : jobCount;
+                jobInvoke(jobContext, begin, end);
+            }
+        } while (stealChunks(index));
+    }
+    
+    /**
+     * @brief Забирает порцию из начала собственной очереди
+     */
+    bool popChunk(unsigned index, std::uint64_t& chunk) {
+        std::atomic<std::uint64_t>& range = queues[index].range;
+        std::uint64_t current = range.load(std::memory_order_acquire);
+        for (;;) {
+            std::uint64_t begin = current >> 32;
+            std::uint64_t end = current & 0xFFFFFFFFu;
+            if (begin >= end) {
+                return false;
+            }
+            if (range.compare_exchange_weak(current, pack(begin + 1, end), std::memory_order_acq_rel)) {
+                chunk = begin;
+                return true;
+            }
+        }
+    }
+    
+    /**
+     * @brief Перехватывает половину порций из конца чужой очереди
+     * @return false, если ни у одного потока не осталось порций
+     */
+    bool stealChunks(unsigned thief) {
+        for (unsigned offset = 1; offset < workerCount; offset++) {
+            std::atomic<std::uint64_t>& victim = queues[(thief + offset) % workerCount].range;
+            std::uint64_t current = victim.load(std::memory_order_acquire);
+            for (;;) {
+                std::uint64_t begin = current >> 32;
+                std::uint64_t end = current & 0xFFFFFFFFu;
+                if (begin >= end) {
+                    break;
+                }
+                std::uint64_t take = (end - begin + 1) / 2;
+                if (victim.compare_exchange_weak(current, pack(begin, end - take), std::memory_order_acq_rel)) {
+                    queues[thief].range.store(pack(end - take, end), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @struct ParallelOptions
+ * @brief Параметры параллельной обработки
+ */
+struct ParallelOptions {
+    std::size_t chunkSize;      ///< Количество полиномов в порции
+    bool recordStatistics;      ///< Регистрировать вычисления корней в PolynomialStatistics
+    bool deterministicSequence; ///< Номер вычисления i-го элемента равен первому номеру пакета + i
+    
+    ParallelOptions() : chunkSize(16384), recordStatistics(false), deterministicSequence(false) {}
+};
+
+/**
+ * @class ParallelPolynomialSolver
+ * @brief Параллельное вычисление корней и значений для массивов полиномов
+ * 
+ * @details
+ * Каждая порция обрабатывается пакетными ядрами solveRootsBatch() и
+ * evaluateBatch(). Результат i-го полинома всегда записывается в i-й элемент
+ * выходных массивов, поэтому порядок результатов не зависит от распределения
+ * работы. При включенной статистике каждая порция регистрируется одной
+ * пакетной записью в шард своего потока; с deterministicSequence номера
+ * вычислений совпадают с индексами элементов (со сдвигом на первый номер).
+ */
+class ParallelPolynomialSolver {
+public:
+    /**
+     * @brief Конструктор
+     * @param threadCount Количество потоков (0 - по числу аппаратных потоков)
+     */
+    explicit ParallelPolynomialSolver(unsigned threadCount = 0) : pool(threadCount) {}
+    
+    /**
+     * @brief Возвращает количество потоков
+     */
+    unsigned threadCount() const {
+        return pool.size();
+    }
+    
+    /**
+     * @brief Находит корни для массивов коэффициентов
+     * @param a Коэффициенты при x²
+     * @param b Коэффициенты при x
+     * @param c Свободные члены
+     * @param n Количество полиномов
+     * @param[out] root1 Первые корни (NaN, если корня нет)
+     * @param[out] root2 Вторые корни (NaN, если корня нет)
+     * @param[out] numRoots Количества корней
+     * @param options Параметры обработки
+     */
+    void findRoots(const double* a, const double* b, const double* c, std::size_t n,
+                   double* root1, double* root2, int* numRoots,
+                   const ParallelOptions& options = ParallelOptions()) {
+        std::uint64_t firstSequence = 0;
+        if (options.recordStatistics && options.deterministicSequence && n > 0) {
+            firstSequence = PolynomialStatistics::reserveRootSequences(n);
+        }
+        
+        auto body = [&](std::size_t begin, std::size_t end) {
+            {
+                PerfCounterScope scope(findRootsPerf, end - begin);
+                solveRootsBatch(a + begin, b + begin, c + begin, end - begin,
+                                root1 + begin, root2 + begin, numRoots + begin);
+            }
+            if (options.recordStatistics) {
+                PolynomialStatistics::recordRootCalculations(
+                    a + begin, b + begin, c + begin, root1 + begin, root2 + begin, numRoots + begin,
+                    end - begin, firstSequence != 0 ? firstSequence + begin : 0);
+            }
+        };
+        pool.parallelFor(n, options.chunkSize, body);
+    }
+    
+    /**
+     * @brief Находит корни всех полиномов массива
+     * @param polynomials Массив полиномов
+     * @param[out] root1 Первые корни (NaN, если корня нет)
+     * @param[out] root2 Вторые корни (NaN, если корня нет)
+     * @param[out] numRoots Количества корней
+     * @param options Параметры обработки
+     */
+    void findRoots(const PolynomialArray& polynomials, double* root1, double* root2, int* numRoots,
+                   const ParallelOptions& options = ParallelOptions()) {
+        findRoots(polynomials.a, polynomials.b, polynomials.c, polynomials.count,
+                  root1, root2, numRoots, options);
+    }
+    
+    /**
+     * @brief Находит корни для колонок коэффициентов без копирования
+     * @param coefficients Колонки коэффициентов (например, из MappedCoefficientFile)
+     * @param[out] root1 Первые корни (NaN, если корня нет)
+     * @param[out] root2 Вторые корни (NaN, если корня нет)
+     * @param[out] numRoots Количества корней
+     * @param options Параметры обработки
+     */
+    void findRoots(const CoefficientSpan& coefficients, double* root1, double* root2, int* numRoots,
+                   const ParallelOptions& options = ParallelOptions()) {
+        findRoots(coefficients.a, coefficients.b, coefficients.c, coefficients.count,
+                  root1, root2, numRoots, options);
+    }
+    
+    /**
+     * @brief Вычисляет значения массивов коэффициентов в одной точке
+     * @param a Коэффициенты при x²
+     * @param b Коэффициенты при x
+     * @param c Свободные члены
+     * @param n Количество полиномов
+     * @param x Точка для вычисления
+     * @param[out] out Значения полиномов
+     * @param options Параметры обработки (используется chunkSize)
+     */
+    void evaluate(const double* a, const double* b, const double* c, std::size_t n,
+                  double x, double* out, const ParallelOptions& options = ParallelOptions()) {
+        auto body = [&](std::size_t begin, std::size_t end) {
+            PerfCounterScope scope(evaluatePerf, end - begin);
+            evaluateBatch(a + begin, b + begin, c + begin, end - begin, x, out + begin);
+        };
+        pool.parallelFor(n, options.chunkSize, body);
+    }
+    
+    /**
+     * @brief Вычисляет значения всех полиномов массива в одной точке
+     * @param polynomials Массив полиномов
+     * @param x Точка для вычисления
+     * @param[out] out Значения полиномов
+     * @param options Параметры обработки (используется chunkSize)
+     */
+    void evaluate(const PolynomialArray& polynomials, double x, double* out,
+                  const ParallelOptions& options = ParallelOptions()) {
+        evaluate(polynomials.a, polynomials.b, polynomials.c, polynomials.count, x, out, options);
+    }
+    
+    /**
+     * @brief Вычисляет значения полиномов из колонок коэффициентов в одной точке
+     * @param coefficients Колонки коэффициентов
+     * @param x Точка для вычисления
+     * @param[out] out Значения полиномов
+     * @param options Параметры обработки (используется chunkSize)
+     */
+    void evaluate(const CoefficientSpan& coefficients, double x, double* out,
+                  const ParallelOptions& options = ParallelOptions()) {
+        evaluate(coefficients.a, coefficients.b, coefficients.c, coefficients.count, x, out, options);
+    }
+
+private:
+    WorkStealingPool pool; ///< Пул потоков
+};
+
+/** @} */ // конец группы ParallelProcessing
+
+/**
+ * @defgroup CoefficientFiles Двоичные файлы коэффициентов
+ * @brief Версионированный колоночный формат наборов коэффициентов
+ * 
+ * @details
+ * Файл состоит из заголовка CoefficientFileHeader и последовательности
+ * чанков. Чанк - заголовок CoefficientChunkHeader с количеством полиномов
+ * n и три колонки a[n], b[n], c[n], каждая дополнена нулями до кратного
+ * 64 байтам размера. Все заголовки занимают по 64 байта, поэтому при
+ * отображении файла в память каждая колонка выровнена по кэш-линии и
+ * передается пакетным ядрам напрямую. Числа хранятся в порядке байтов
+ * платформы, совместимость проверяется по полю byteOrder.
+ * @{
+ */
+
+/**
+ * @struct CoefficientFileHeader
+ * @brief Заголовок файла коэффициентов (64 байта)
+ */
+struct CoefficientFileHeader {
+    char magic[8];              ///< Сигнатура "QUADCOEF"
+    std::uint32_t version;      ///< Версия формата
+    std::uint32_t byteOrder;    ///< 0x01020304 в порядке байтов записавшей платформы
+    std::uint64_t count;        ///< Общее количество полиномов
+    std::uint64_t chunkCount;   ///< Количество чанков
+    std::uint64_t chunkCapacity; ///< Наибольшее количество полиномов в чанке
+    std::uint64_t dataOffset;   ///< Смещение первого чанка от начала файла
+    std::uint64_t reserved[2];  ///< Резерв (нули)
+};
+
+/**
+ * @struct CoefficientChunkHeader
+ * @brief Заголовок чанка (64 байта)
+ */
+struct CoefficientChunkHeader {
+    std::uint64_t count;        ///< Количество полиномов в чанке
+    std::uint64_t reserved[7];  ///< Резерв (нули)
+};
+
+static_assert(sizeof(CoefficientFileHeader) == 64, "Zagolovok fayla dolzhen zanimat 64 bayta");
+static_assert(sizeof(CoefficientChunkHeader) == 64, "Zagolovok chanka dolzhen zanimat 64 bayta");
+
+const char coefficientFileMagic[8] = {'Q', 'U', 'A', 'D', 'C', 'O', 'E', 'F'}; ///< Сигнатура формата
+const std::uint32_t coefficientFileVersion = 1;             ///< Текущая версия формата
+const std::uint32_t coefficientFileByteOrder = 0x01020304;  ///< Метка порядка байтов
+
+/**
+ * @brief Возвращает размер колонки из n чисел с выравнивающим дополнением
+ * @param n Количество полиномов
+ * @return Размер в байтах, кратный 64
+ */
+inline std::uint64_t coefficientColumnBytes(std::uint64_t n) {
+    return (n * sizeof(double) + 63) & ~std::uint64_t(63);
+}
+
+/**
+ * @class CoefficientFileWriter
+ * @brief Потоковая запись файла коэффициентов
+ * 
+ * @details
+ * Коэффициенты накапливаются в PolynomialArray емкостью в один чанк и
+ * записываются по мере заполнения, поэтому объем памяти не зависит от
+ * размера набора. Итоговые count и chunkCount записываются в заголовок
+ * при close().
+ */
+class CoefficientFileWriter {
+public:
+    static const std::size_t defaultChunkCapacity = 1 << 16; ///< Емкость чанка по умолчанию
+    
+    /**
+     * @brief Создает файл и записывает предварительный заголовок
+     * @param path Путь к файлу
+     * @param chunkCapacity Наибольшее количество полиномов в чанке
+     * @throws std::invalid_argument при нулевой емкости чанка
+     * @throws std::runtime_error если файл не удалось создать
+     */
+    explicit CoefficientFileWriter(const char* path, std::size_t chunkCapacity = defaultChunkCapacity)
+        : file(nullptr), capacity(chunkCapacity), total(0), chunks(0) {
+        if (chunkCapacity == 0) {
+            throw std::invalid_argument("Razmer chanka dolzhen byt polozhitelnym");
+        }
+        file = std::fopen(path, "wb");
+        if (file == nullptr) {
+            throw std::runtime_error(std::string("Ne udalos sozdat fayl: ") + path);
+        }
+        staging.reserve(capacity);
+        writeHeader();
+    }
+    
+    CoefficientFileWriter(const CoefficientFileWriter&) = delete;
+    CoefficientFileWriter& operator=(const CoefficientFileWriter&) = delete;
+    
+    /**
+     * @brief Деструктор
+     * @note Ошибки записи при неявном закрытии игнорируются, чтобы их
+     * увидеть, нужно вызвать close() явно
+     */
+    ~CoefficientFileWriter() {
+        if (file != nullptr) {
+            try {
+                close();
+            } catch (const std::exception&) {
+            }
+        }
+    }
+    
+    /**
+     * @brief Дописывает колонки коэффициентов
+     * @param a Коэффициенты при x²
+     * @param b Коэффициенты при x
+     * @param c Свободные члены
+     * @param n Количество полиномов
+     * @throws std::runtime_error при ошибке записи
+     */
+    void append(const double* a, const double* b, const double* c, std::size_t n) {
+        while (n > 0) {
+            std::size_t take = std::min(n, capacity - staging.count);
+            staging.append(a, b, c, take);
+            a += take;
+            b += take;
+            c += take;
+            n -= take;
+            if (staging.count == capacity) {
+                writeChunk();
+            }
+        }
+    }
+    
+    /**
+     * @brief Записывает последний чанк и окончательный заголовок
+     * @throws std::runtime_error при ошибке записи
+     */
+    void close() {
+        if (file == nullptr) {
+            return;
+        }
+        std::FILE* closing = file;
+        bool ok = true;
+        try {
+            if (staging.count > 0) {
+                writeChunk();
+            }
+            ok = std::fseek(file, 0, SEEK_SET) == 0;
+            if (ok) {
+                writeHeader();
+            }
+        } catch (const std::runtime_error&) {
+            ok = false;
+        }
+        file = nullptr;
+        if (std::fclose(closing) != 0 || !ok) {
+            throw std::runtime_error("Oshibka zapisi fayla koefficientov");
+        }
+    }
+    
+    /**
+     * @brief Возвращает количество записанных полиномов
+     */
+    std::uint64_t size() const {
+        return total + staging.count;
+    }
+
+private:
+    std::FILE* file;            ///< Файл (nullptr после close())
+    std::size_t capacity;       ///< Емкость чанка
+    PolynomialArray staging;    ///< Коэффициенты незаписанного чанка
+    std::uint64_t total;        ///< Количество полиномов в записанных чанках
+    std::uint64_t chunks;       ///< Количество записанных чанков
+    
+    void writeBytes(const void* data, std::size_t bytes) {
+        if (std::fwrite(data, 1, bytes, file) != bytes) {
+            throw std::runtime_error("Oshibka zapisi fayla koefficientov");
+        }
+    }
+    
+    void writeHeader() {
+        CoefficientFileHeader header = {};
+        std::memcpy(header.magic, coefficientFileMagic, sizeof(header.magic));
+        header.version = coefficientFileVersion;
+        header.byteOrder = coefficientFileByteOrder;
+        header.count = total;
+        header.chunkCount = chunks;
+        header.chunkCapacity = capacity;
+        header.dataOffset = sizeof(CoefficientFileHeader);
+        writeBytes(&header, sizeof(header));
+    }
+    
+    void writeColumn(const double* column, std::size_t n) {
+        static const char padding[64] = {};
+        writeBytes(column, n * sizeof(double));
+        writeBytes(padding, static_cast<std::size_t>(coefficientColumnBytes(n) - n * sizeof(double)));
+    }
+    
+    void writeChunk() {
+        CoefficientChunkHeader header = {};
+        header.count = staging.count;
+        writeBytes(&header, sizeof(header));
+        writeColumn(staging.a, staging.count);
+        writeColumn(staging.b, staging.count);
+        writeColumn(staging.c, staging.count);
+        total += staging.count;
+        chunks++;
+        staging.count = 0;
+    }
+};
+
+/**
+ * @class MappedCoefficientFile
+ * @brief Файл коэффициентов, отображенный в память только для чтения
+ * 
+ * @details
+ * Файл отображается mmap() целиком, при открытии проверяются заголовок и
+ * границы всех чанков. Чанки выдаются как CoefficientSpan, указывающие
+ * прямо в отображение, поэтому открытие не читает данные, а страницы
+ * загружаются по мере обращения и разделяются кэшем страниц между
+ * процессами. На платформах без mmap() файл читается в выровненный буфер.
+ */
+class MappedCoefficientFile {
+public:
+    /**
+     * @brief Открывает и проверяет файл
+     * @param path Путь к файлу
+     * @throws std::runtime_error если файл не открывается или поврежден
+     */
+    explicit MappedCoefficientFile(const char* path) : data(nullptr), bytes(0), total(0) {
+        map(path);
+        try {
+            parse();
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+    
+    MappedCoefficientFile(const MappedCoefficientFile&) = delete;
+    MappedCoefficientFile& operator=(const MappedCoefficientFile&) = delete;
+    
+    ~MappedCoefficientFile() {
+        unmap();
+    }
+    
+    /**
+     * @brief Проверяет, начинается ли файл с сигнатуры формата
+     * @param path Путь к файлу
+     * @return false, если файл не открывается или сигнатура не совпала
+     */
+    static bool hasSignature(const char* path) {
+        std::FILE* file = std::fopen(path, "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        char magic[sizeof(coefficientFileMagic)];
+        bool matches = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                       std::memcmp(magic, coefficientFileMagic, sizeof(magic)) == 0;
+        std::fclose(file);
+        return matches;
+    }
+    
+    /**
+     * @brief Возвращает общее количество полиномов
+     */
+    std::uint64_t size() const {
+        return total;
+    }
+    
+    /**
+     * @brief Возвращает количество чанков
+     */
+    std::size_t chunkCount() const {
+        return chunks.size();
+    }
+    
+    /**
+     * @brief Возвращает колонки i-го чанка
+     * @param i Индекс чанка
+     */
+    const CoefficientSpan& chunk(std::size_t i) const {
+        return chunks[i];
+    }
+
+private:
+    unsigned char* data;                ///< Начало отображения
+    std::size_t bytes;                  ///< Размер файла
+    std::uint64_t total;                ///< Количество полиномов
+    std::vector<CoefficientSpan> chunks; ///< Колонки чанков
+    
+    static std::runtime_error corrupted(const char* detail) {
+        return std::runtime_error(std::string("Fayl koefficientov povrezhden: ") + detail);
+    }
+    
+    void map(const char* path) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error(std::string("Ne udalos otkryt fayl: ") + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(CoefficientFileHeader))) {
+            ::close(fd);
+            throw corrupted("fayl koroche zagolovka");
+        }
+        bytes = static_cast<std::size_t>(info.st_size);
+        void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error(std::string("Ne udalos otobrazit fayl v pamyat: ") + path);
+        }
+        ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+        data = static_cast<unsigned char*>(mapping);
+#else
+        std::FILE* file = std::fopen(path, "rb");
+        if (file == nullptr) {
+            throw std::runtime_error(std::string("Ne udalos otkryt fayl: ") + path);
+        }
+        std::fseek(file, 0, SEEK_END);
+        long size = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        if (size < static_cast<long>(sizeof(CoefficientFileHeader))) {
+            std::fclose(file);
+            throw corrupted("fayl koroche zagolovka");
+        }
+        bytes = static_cast<std::size_t>(size);
+        data = static_cast<unsigned char*>(::operator new(bytes, std::align_val_t(PolynomialArray::alignment)));
+        bool ok = std::fread(data, 1, bytes, file) == bytes;
+        std::fclose(file);
+        if (!ok) {
+            unmap();
+            throw std::runtime_error(std::string("Oshibka chteniya fayla: ") + path);
+        }
+#endif
+    }
+    
+    void unmap() {
+        if (data == nullptr) {
+            return;
+        }
+#if defined(__unix__) || defined(__APPLE__)
+        ::munmap(data, bytes);
+#else
+        ::operator delete(data, std::align_val_t(PolynomialArray::alignment));
+#endif
+        data = nullptr;
+        chunks.clear();
+    }
+    
+    void parse() {
+        CoefficientFileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, coefficientFileMagic, sizeof(header.magic)) != 0) {
+            throw corrupted("neizvestnaya signatura");
+        }
+        if (header.version != coefficientFileVersion) {
+            throw std::runtime_error("Nepodderzhivaemaya versiya fayla koefficientov: " +
+                                     std::to_string(header.version));
+        }
+        if (header.byteOrder != coefficientFileByteOrder) {
+            throw std::runtime_error("Fayl koefficientov zapisan s drugim poryadkom baytov");
+        }
+        if (header.dataOffset < sizeof(header) || header.dataOffset % 64 != 0 || header.dataOffset > bytes) {
+            throw corrupted("nekorrektnoe smeshchenie dannyh");
+        }
+        if (header.chunkCount > (bytes - header.dataOffset) / sizeof(CoefficientChunkHeader)) {
+            throw corrupted("slishkom mnogo chankov");
+        }
+        
+        chunks.reserve(static_cast<std::size_t>(header.chunkCount));
+        std::uint64_t offset = header.dataOffset;
+        for (std::uint64_t i = 0; i < header.chunkCount; i++) {
+            if (bytes - offset < sizeof(CoefficientChunkHeader)) {
+                throw corrupted("obrezannyy zagolovok chanka");
+            }
+            CoefficientChunkHeader chunkHeader;
+            std::memcpy(&chunkHeader, data + offset, sizeof(chunkHeader));
+            offset += sizeof(chunkHeader);
+            
+            std::uint64_t n = chunkHeader.count;
+            if (n > (bytes - offset) / (3 * sizeof(double))) {
+                throw corrupted("obrezannyy chank");
+            }
+            std::uint64_t columnBytes = coefficientColumnBytes(n);
+            if (3 * columnBytes > bytes - offset) {
+                throw corrupted("obrezannyy chank");
+            }
+            
+            const double* column = reinterpret_cast<const double*>(data + offset);
+            CoefficientSpan span = {column,
+                                    column + columnBytes / sizeof(double),
+                                    column + 2 * (columnBytes / sizeof(double)),
+                                    static_cast<std::size_t>(n)};
+            chunks.push_back(span);
+            offset += 3 * columnBytes;
+            total += n;
+        }
+        if (total != header.count) {
+            throw corrupted("kolichestvo polinomov ne sovpadaet s zagolovkom");
+        }
+    }
+};
+
+/** @} */ // конец группы CoefficientFiles
+
+
+/**
+ * @defgroup HelperFunctions Вспомогательные функции
+ * @brief Функции для поддержки работы программы
+ * @{
+ */
+
+/**
+ * @brief Выводит корни уравнения в читаемом формате
+ * @param root1 Первый корень
+ * @param root2 Второй корень
+ * @param numRoots Количество корней (0, 1 или 2)
+ * 
+ * @details
+ * Форматированный вывод корней:
+ * - 0 корней: "Net deystvitelnyh korney"
+ * - 1 корень: "Odin koren: x = value"
+ * - 2 корня: "Dva kornya: x1 = value1, x2 = value2"
+ */
+void printRoots(double root1, double root2, int numRoots) {
+    if (numRoots == 0) {
+        std::cout << "Net deystvitelnyh korney" << std::endl;
+    } else if (numRoots == 1) {
+        std::cout << "Odin koren: x = " << root1 << std::endl;
+    } else {
+        std::cout << "Dva kornya: x1 = " << root1 << ", x2 = " << root2 << std::endl;
+    }
+}
+
+/**
+ * @brief Тестирует все операции для заданного полинома
+ * @param p Полином для тестирования
+ * @return true - вернуться в главное меню, false - продолжить тестирование
+ * 
+ * @details
+ * Предоставляет интерактивное меню для тестирования:
+ * 1. Унарные операции (++, --)
+ * 2. Бинарные операции (+, -, *, /)
+ * 3. Операции сравнения
+ * 4. Нахождение корней
+ * 5. Вычисление значения
+ * 6. Вернуться к выбору полинома
+ * 7. Вернуться в главное меню
+ */
+bool testAllOperations(PolynomialView& p) {
+    std::cout << "\n----- Test vseh operaciy dlya polynoma: ";
+    p.print();
+    std::cout << " -----" << std::endl;
+    
+    Polynomial original_p(p);
+    
+    int testChoice;
+    do {
+        std::cout << "\nViberite operaciyu:" << std::endl;
+        std::cout << "1. Unarnye operacii (++, --)" << std::endl;
+        std::cout << "2. Binarnye operacii (+, -, *, /)" << std::endl;
+        std::cout << "3. Operacii sravneniya (<, >, ==, !=)" << std::endl;
+        std::cout << "4. Nahozhdenie korney" << std::endl;
+        std::cout << "5. Vychislit znachenie" << std::endl;
+        std::cout << "6. Vernutsya k viboru polynoma" << std::endl;
+        std::cout << "7. Vernutsya v glavnoe menu" << std::endl;
+        std::cout << "Vash vibor: ";
+        std::cin >> testChoice;
+        
+        if (testChoice == 1) {
+            std::cout << "\n--- Unarnye operacii ---" << std::endl;
+            std::cout << "Tekushiy polynom: ";
+            p.print();
+            std::cout << std::endl;
+            
+            std::cout << "\n1. ++p (prefix increment)" << std::endl;
+            std::cout << "   Do: "; p.print(); std::cout << std::endl;
+            PolynomialView& result_pre_inc = ++p;
+            std::cout << "   Posle ++p: "; p.print(); std::cout << std::endl;
+            std::cout << "   Rezultat (ssylka): "; result_pre_inc.print(); std::cout << std::endl;
+            
+            std::cout << "\n2. p++ (postfix increment)" << std::endl;
+            std::cout << "   Do: "; p.print(); std::cout << std::endl;
+            Polynomial result_post_inc(p++);
+            std::cout << "   Posle p++: "; p.print(); std::cout << std::endl;
+            std::cout << "   Rezultat (kopiya): "; result_post_inc.print(); std::cout << std::endl;
+            
+            std::cout << "\n3. --p (prefix decrement)" << std::endl;
+            std::cout << "   Do: "; p.print(); std::cout << std::endl;
+            PolynomialView& result_pre_dec = --p;
+            std::cout << "   Posle --p: "; p.print(); std::cout << std::endl;
+            std::cout << "   Rezultat (ssylka): "; result_pre_dec.print(); std::cout << std::endl;
+            
+            std::cout << "\n4. p-- (postfix decrement)" << std::endl;
+            std::cout << "   Do: "; p.print(); std::cout << std::endl;
+            Polynomial result_post_dec(p--);
+            std::cout << "   Posle p--: "; p.print(); std::cout << std::endl;
+            std::cout << "   Rezultat (kopiya): "; result_post_dec.print(); std::cout << std::endl;
+            
+            p = PolynomialView(original_p);
+            
+        } else if (testChoice == 2) {
+            std::cout << "\n--- Binarnye operacii ---" << std::endl;
+            
+            std::cout << "Vvedite vtoroy polynom (a b c): ";
+            double a, b, c;
+            std::cin >> a >> b >> c;
+            Polynomial other(a, b, c);
+            
+            std::cout << "\nOperacii s polynomami:" << std::endl;
+            std::cout << "p1: "; p.print(); std::cout << std::endl;
+            std::cout << "p2: "; other.print(); std::cout << std::endl;
+            
+            std::cout << "\n1. p1 + p2 = "; (Polynomial(p) + other).print(); std::cout << std::endl;
+            std::cout << "2. p1 - p2 = "; (Polynomial(p) - other).print(); std::cout << std::endl;
+            
+            double scalar;
+            std::cout << "\nVvedite chislo dlya umnozheniya/deleniya: ";
+            std::cin >> scalar;
+            
+            std::cout << "3. p1 * " << scalar << " = "; (Polynomial(p) * scalar).print(); std::cout << std::endl;
+            std::cout << "4. " << scalar << " * p1 = "; Polynomial(scalar * p).print(); std::cout << std::endl;
+            
+            if (scalar != 0) {
+                std::cout << "5. p1 / " << scalar << " = "; (Polynomial(p) / scalar).print(); std::cout << std::endl;
+            } else {
+                std::cout << "5. p1 / 0 = Nelzya delit na nol!" << std::endl;
+            }
+            
+        } else if (testChoice == 3) {
+            std::cout << "\n--- Operacii sravneniya ---" << std::endl;
+            
+            std::cout << "Vvedite vtoroy polynom (a b c): ";
+            double a, b, c;
+            std::cin >> a >> b >> c;
+            Polynomial other(a, b, c);
+            
+            double x = 2.0;
+            
+            std::cout << "\nSravnenie polynomov pri x = " << x << ":" << std::endl;
+            std::cout << "p1: "; p.print(); 
+            std::cout << " = " << p.evaluate(x) << std::endl;
+            std::cout << "p2: "; other.print(); 
+            std::cout << " = " << other.evaluate(x) << std::endl;
+            
+            std::cout << "\nRezultaty sravneniya:" << std::endl;
+            
+            double val1 = p.evaluate(x);
+            double val2 = other.evaluate(x);
+            // Операторы сравнения определены для полиномов одного типа
+            const PolynomialView otherView(other);
+            
+            std::cout << "p1 < p2: " << (p < otherView ? "DA" : "NET") << std::endl;
+            std::cout << "p1 > p2: " << (p > otherView ? "DA" : "NET") << std::endl;
+            std::cout << "p1 <= p2: " << (p <= otherView ? "DA" : "NET") << std::endl;
+            std::cout << "p1 >= p2: " << (p >= otherView ? "DA" : "NET") << std::endl;
+            std::cout << "p1 == p2: " << (p == otherView ? "DA" : "NET") << std::endl;
+            std::cout << "p1 != p2: " << (p != otherView ? "DA" : "NET") << std::endl;
+            
+            std::cout << "\nItog:" << std::endl;
+            if (val1 > val2) {
+                std::cout << "p1 > p2" << std::endl;
+            } else if (val1 < val2) {
+                std::cout << "p1 < p2" << std::endl;
+            } else {
+                std::cout << "p1 = p2" << std::endl;
+            }
+            
+        } else if (testChoice == 4) {
+            std::cout << "\n--- Nahozhdenie korney ---" << std::endl;
+            std::cout << "Polynom: "; p.print(); std::cout << std::endl;
+            
+            double root1 = 0.0, root2 = 0.0;
+            int numRoots;
+            p.findRoots(root1, root2, numRoots);
+            std::cout << "Korni: ";
+            printRoots(root1, root2, numRoots);
+            
+        } else if (testChoice == 5) {
+            std::cout << "\n--- Vychislenie znacheniya ---" << std::endl;
+            double x;
+            std::cout << "Vvedite x: ";
+            std::cin >> x;
+            std::cout << "p(" << x << ") = " << p.evaluate(x) << std::endl;
+            
+        } else if (testChoice == 6) {
+            std::cout << "Vozvrashchenie k viboru polynoma..." << std::endl;
+            p = PolynomialView(original_p);
+            return false;
+            
+        } else if (testChoice == 7) {
+            std::cout << "Vozvrashenie v glavnoe menu..." << std::endl;
+            p = PolynomialView(original_p);
+            return true;
+            
+        } else {
+            std::cout << "Nekorrektny vibor!" << std::endl;
+        }
+        
+    } while (true);
+}
+
+/** @} */ // конец группы HelperFunctions
+
+/**
+ * @defgroup BatchMode Пакетный режим
+ * @brief Неинтерактивная потоковая обработка коэффициентов
+ * @{
+ */
+
+/**
+ * @struct BatchOptions
+ * @brief Параметры пакетного режима
+ */
+struct BatchOptions {
+    const char* inputPath;          ///< Входной файл (nullptr - стандартный ввод)
+    const char* outputPath;         ///< Выходной файл (nullptr - стандартный вывод)
+    bool binaryOutput;              ///< true - двоичный вывод, false - CSV
+    std::vector<double> evalPoints; ///< Точки, в которых вычисляются значения полиномов
+    unsigned threads;               ///< Количество потоков обработки блока
+    std::size_t blockSize;          ///< Количество полиномов в блоке
+    std::size_t chunkCapacity;      ///< Емкость чанка при записи файла коэффициентов
+    
+    BatchOptions()
+        : inputPath(nullptr), outputPath(nullptr), binaryOutput(false), threads(1), blockSize(65536),
+          chunkCapacity(CoefficientFileWriter::defaultChunkCapacity) {}
+};
+
+/**
+ * @class TextCoefficientReader
+ * @brief Потоковое чтение записей "a b c" из текстового файла
+ * 
+ * @details
+ * Читает файл блоками фиксированного размера и разбирает числа strtod()
+ * прямо в буфере, поэтому объем памяти не зависит от размера входа.
+ * Разделителями считаются пробельные символы и запятые.
+ */
+class TextCoefficientReader {
+public:
+    /**
+     * @brief Конструктор
+     * @param input Открытый входной поток
+     */
+    explicit TextCoefficientReader(std::FILE* input)
+        : file(input), buffer(new char[bufferSize + 1]), begin(0), end(0), eof(false), valuesRead(0) {
+        buffer[0] = '\0';
+    }
+    
+    TextCoefficientReader(const TextCoefficientReader&) = delete;
+    TextCoefficientReader& operator=(const TextCoefficientReader&) = delete;
+    
+    ~TextCoefficientReader() {
+        delete[] buffer;
+    }
+    
+    /**
+     * @brief Читает до maxCount записей в колонки коэффициентов
+     * @param[out] a Коэффициенты при x²
+     * @param[out] b Коэффициенты при x
+     * @param[out] c Свободные члены
+     * @param maxCount Емкость колонок
+     * @return Количество прочитанных записей (0 - конец входа)
+     * @throws std::runtime_error при некорректном числе или неполной записи
+     * @note Если ошибка встретилась после корректных записей блока, сначала
+     * возвращаются эти записи, а исключение выбрасывается при следующем вызове
      */
-    double getA() const { return a; }
+    std::size_t readBlock(double* a, double* b, double* c, std::size_t maxCount) {
+        if (!pendingError.empty()) {
+            throw std::runtime_error(pendingError);
+        }
+        
+        std::size_t n = 0;
+        try {
+            while (n < maxCount && nextValue(a[n])) {
+                if (!nextValue(b[n]) || !nextValue(c[n])) {
+                    throw std::runtime_error("Nepolnaya zapis v konce vhoda (ozhidalos 3 chisla)");
+                }
+                n++;
+            }
+        } catch (const std::runtime_error& e) {
+            if (n == 0) {
+                throw;
+            }
+            pendingError = e.what();
+        }
+        return n;
+    }
+
+private:
+    static const std::size_t bufferSize = 1 << 20; ///< Размер буфера чтения
+    
+    std::FILE* file;        ///< Входной поток
+    char* buffer;           ///< Буфер чтения (с завершающим нулем)
+    std::size_t begin;      ///< Начало непрочитанных данных
+    std::size_t end;        ///< Конец данных в буфере
+    bool eof;               ///< Достигнут конец входа
+    std::uint64_t valuesRead; ///< Количество разобранных чисел (для сообщений об ошибках)
+    std::string pendingError; ///< Ошибка, отложенная до следующего блока
+    
+    static bool isSeparator(char ch) {
+        return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' || ch == ',';
+    }
     
     /**
-     * @brief Возвращает коэффициент b
-     * @return Коэффициент при x
+     * @brief Переносит остаток данных в начало буфера и дочитывает вход
      */
-    double getB() const { return b; }
+    void refill() {
+        std::size_t remaining = end - begin;
+        std::memmove(buffer, buffer + begin, remaining);
+        begin = 0;
+        end = remaining;
+        
+        std::size_t got = std::fread(buffer + end, 1, bufferSize - end, file);
+        end += got;
+        buffer[end] = '\0';
+        if (got == 0) {
+            eof = true;
+        }
+    }
     
     /**
-     * @brief Возвращает коэффициент c
-     * @return Свободный член
+     * @brief Разбирает очередное число
+     * @param[out] value Прочитанное значение
+     * @return false, если вход закончился
+     */
+    bool nextValue(double& value) {
+        for (;;) {
+            while (begin < end && isSeparator(buffer[begin])) {
+                begin++;
+            }
+            if (begin < end) {
+                std::size_t tokenEnd = begin;
+                while (tokenEnd < end && !isSeparator(buffer[tokenEnd])) {
+                    tokenEnd++;
+                }
+                // Число может продолжаться в следующей порции файла
+                if (tokenEnd < end || eof) {
+                    char saved = buffer[tokenEnd];
+                    buffer[tokenEnd] = '\0';
+                    char* parsedEnd = nullptr;
+                    value = std::strtod(buffer + begin, &parsedEnd);
+                    bool valid = parsedEnd == buffer + tokenEnd;
+                    std::string token(buffer + begin, tokenEnd - begin);
+                    buffer[tokenEnd] = saved;
+                    
+                    if (!valid) {
+                        throw std::runtime_error("Nekorrektnoe chislo '" + token + "' (zapis #" +
+                                                 std::to_string(valuesRead / 3 + 1) + ")");
+                    }
+                    begin = tokenEnd;
+                    valuesRead++;
+                    return true;
+                }
+                if (begin == 0 && end == bufferSize) {
+                    throw std::runtime_error("Slishkom dlinnoe chislo vo vhodnyh dannyh");
+                }
+            } else if (eof) {
+                return false;
+            }
+            refill();
+        }
+    }
+};
+
+/**
+ * @class BatchOutput
+ * @brief Буферизованный вывод результатов пакетного режима
+ * 
+ * @details
+ * Результаты накапливаются в буфере фиксированного размера и сбрасываются
+ * одним вызовом fwrite(), без сброса потока на каждой строке.
+ * 
+ * Формат CSV: заголовок "a,b,c,num_roots,root1,root2[,p(x)...]", пустые
+ * поля для несуществующих корней. Двоичный формат: последовательность
+ * записей int32 numRoots, int32 (резерв), затем double a, b, c, root1,
+ * root2 и по одному double на каждую точку вычисления (порядок байтов
+ * платформы, несуществующие корни - NaN).
+ */
+class BatchOutput {
+public:
+    /**
+     * @brief Конструктор
+     * @param output Открытый выходной поток
      */
-    double getC() const { return c; }
+    explicit BatchOutput(std::FILE* output)
+        : file(output), buffer(new char[bufferSize]), used(0) {}
     
-    /** @} */ // конец группы GetterMethods
+    BatchOutput(const BatchOutput&) = delete;
+    BatchOutput& operator=(const BatchOutput&) = delete;
+    
+    /**
+     * @brief Деструктор
+     * @details Дописывает оставшиеся данные без исключений: сюда попадают и
+     * при раскрутке стека после ошибки входных данных, когда выход может
+     * быть уже недоступен. При успешной обработке вызывающий код сам вызывает
+     * flush(), чтобы узнать об ошибке записи.
+     */
+    ~BatchOutput() {
+        if (used > 0) {
+            std::fwrite(buffer, 1, used, file);
+        }
+        delete[] buffer;
+    }
+    
+    /**
+     * @brief Записывает заголовок CSV
+     * @param evalPoints Точки вычисления значений
+     */
+    void writeCsvHeader(const std::vector<double>& evalPoints) {
+        write("a,b,c,num_roots,root1,root2");
+        for (double x : evalPoints) {
+            write(",p(");
+            writeNumber(x);
+            write(")");
+        }
+        write("\n");
+    }
+    
+    /**
+     * @brief Записывает одну строку CSV
+     */
+    void writeCsvRow(double a, double b, double c, int numRoots, double root1, double root2,
+                     const double* values, std::size_t valueCount) {
+        reserve(64 + 32 * (5 + valueCount));
+        writeNumber(a);
+        put(',');
+        writeNumber(b);
+        put(',');
+        writeNumber(c);
+        put(',');
+        put(static_cast<char>('0' + numRoots));
+        put(',');
+        if (numRoots > 0) {
+            writeNumber(root1);
+        }
+        put(',');
+        if (numRoots > 1) {
+            writeNumber(root2);
+        }
+        for (std::size_t j = 0; j < valueCount; j++) {
+            put(',');
+            writeNumber(values[j]);
+        }
+        put('\n');
+    }
+    
+    /**
+     * @brief Записывает одну двоичную запись
+     */
+    void writeBinaryRecord(double a, double b, double c, int numRoots, double root1, double root2,
+                           const double* values, std::size_t valueCount) {
+        std::int32_t header[2] = {numRoots, 0};
+        double coefficients[5] = {a, b, c, root1, root2};
+        writeBytes(header, sizeof(header));
+        writeBytes(coefficients, sizeof(coefficients));
+        writeBytes(values, valueCount * sizeof(double));
+    }
+    
+    /**
+     * @brief Сбрасывает буфер в выходной поток
+     * @throws std::runtime_error при ошибке записи
+     */
+    void flush() {
+        if (used > 0 && std::fwrite(buffer, 1, used, file) != used) {
+            used = 0;
+            throw std::runtime_error("Oshibka zapisi rezultatov");
+        }
+        used = 0;
+    }
+
+private:
+    static const std::size_t bufferSize = 1 << 20; ///< Размер буфера вывода
+    
+    std::FILE* file;    ///< Выходной поток
+    char* buffer;       ///< Буфер вывода
+    std::size_t used;   ///< Заполненная часть буфера
+    
+    void reserve(std::size_t bytes) {
+        if (used + bytes > bufferSize) {
+            flush();
+        }
+    }
+    
+    void put(char ch) {
+        buffer[used++] = ch;
+    }
+    
+    void write(const char* text) {
+        writeBytes(text, std::strlen(text));
+    }
+    
+    void writeBytes(const void* data, std::size_t bytes) {
+        if (bytes > bufferSize) {
+            flush();
+            if (std::fwrite(data, 1, bytes, file) != bytes) {
+                throw std::runtime_error("Oshibka zapisi rezultatov");
+            }
+            return;
+        }
+        reserve(bytes);
+        std::memcpy(buffer + used, data, bytes);
+        used += bytes;
+    }
+    
+    /**
+     * @brief Записывает кратчайшее точное десятичное представление числа
+     */
+    void writeNumber(double value) {
+        reserve(32);
+        std::to_chars_result result = std::to_chars(buffer + used, buffer + bufferSize, value);
+        used = static_cast<std::size_t>(result.ptr - buffer);
+    }
 };
 
-/** @} */ // конец группы PolynomialClass
+/**
+ * @brief Выводит справку по параметрам командной строки
+ * @param program Имя программы
+ */
+void printUsage(const char* program) {
+    std::cerr << "Ispolzovanie:\n"
+              << "  " << program << "                      interaktivnoe menu\n"
+              << "  " << program << " --batch [parametry]  paketnaya obrabotka\n"
+              << "  " << program << " --convert --input FILE --output FILE [--chunk N]\n"
+              << "      preobrazovat zapisi \"a b c\" v dvoichnyy fayl koefficientov\n"
+              << "  " << program << " --bench [--json] [--min-time MS] [--filter TEXT]\n"
+              << "      zamery proizvoditelnosti osnovnyh operaciy\n"
+              << "      (allocs/op - tolko pri sborke s -DPOLY_BENCH_ALLOCATIONS)\n"
+              << "  " << program << " --selfcheck          sravnit vektornye yadra korney so skalyarnymi\n"
+              << "\nParametry paketnogo rezhima:\n"
+              << "  --input FILE       vhodnoy fayl: zapisi \"a b c\" ili dvoichnyy fayl\n"
+              << "                     koefficientov (po umolchaniyu stdin, tolko tekst)\n"
+              << "  --output FILE      fayl rezultatov (po umolchaniyu stdout)\n"
+              << "  --format csv|binary  format vyvoda (po umolchaniyu csv)\n"
+              << "  --eval X[,X...]    vychislit znacheniya polinomov v tochkah X\n"
+              << "  --threads N        kolichestvo potokov (0 - vse yadra, po umolchaniyu 1)\n"
+              << "  --block N          kolichestvo polinomov v bloke (po umolchaniyu 65536)\n"
+              << "  --chunk N          polinomov v chanke fayla koefficientov (po umolchaniyu 65536)\n"
+              << "\nPeremennye okruzheniya:\n"
+              << "  POLY_ISA=auto|scalar|avx2|avx512  nabor instrukciy vychislitelnyh yader\n"
+              << "                     (po umolchaniyu auto - vybor po CPUID, sejchas "
+              << kernelIsaName(activeKernelIsa) << ")\n"
+              << "  POLY_LATENCY=1      gistogrammy zaderzhek findRoots, evaluate, operatorov,\n"
+              << "                     PolynomialArray::add i destruktora v statistike\n"
+              << "  POLY_PERF=1         apparatnye schetchiki (cycles, instructions, branch-misses,\n"
+              << "                     cache-misses) vokrug paketov findRoots i evaluate\n";
+}
+
+/**
+ * @brief Разбирает список точек вида "x1,x2,..."
+ * @param text Строка с точками
+ * @param[out] points Прочитанные точки
+ * @throws std::invalid_argument при некорректном числе
+ */
+void parseEvalPoints(const char* text, std::vector<double>& points) {
+    while (*text != '\0') {
+        char* parsedEnd = nullptr;
+        double x = std::strtod(text, &parsedEnd);
+        if (parsedEnd == text || (*parsedEnd != ',' && *parsedEnd != '\0')) {
+            throw std::invalid_argument(std::string("Nekorrektnaya tochka v --eval: ") + text);
+        }
+        points.push_back(x);
+        text = (*parsedEnd == ',') ? parsedEnd + 1 : parsedEnd;
+    }
+}
+
+/**
+ * @brief Разбирает неотрицательное целое значение параметра
+ * @param arg Название параметра (для сообщения об ошибке)
+ * @param text Значение параметра
+ * @return Прочитанное число
+ * @throws std::invalid_argument если строка - не десятичное число целиком
+ * или число не помещается в std::size_t
+ */
+std::size_t parseCountOption(const std::string& arg, const char* text) {
+    char* parsedEnd = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(text, &parsedEnd, 10);
+    // strtoull пропускает пробелы и принимает минус, молча обращая значение,
+    // поэтому число должно начинаться с цифры
+    if (text[0] < '0' || text[0] > '9' || *parsedEnd != '\0' || errno == ERANGE ||
+        value > std::numeric_limits<std::size_t>::max()) {
+        throw std::invalid_argument("Neizvestnyy ili nepolnyy parametr: " + arg + " " + text);
+    }
+    return static_cast<std::size_t>(value);
+}
+
+/**
+ * @brief Разбирает параметры пакетного режима
+ * @param argc Количество аргументов
+ * @param argv Аргументы командной строки
+ * @param[out] options Параметры пакетного режима
+ * @throws std::invalid_argument при неизвестном или неполном параметре или
+ * некорректном числе в --threads, --block, --chunk
+ */
+void parseBatchOptions(int argc, char* argv[], BatchOptions& options) {
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Neizvestnyy ili nepolnyy parametr: " + arg);
+        }
+        const char* value = argv[++i];
+        
+        if (arg == "--input") {
+            options.inputPath = value;
+        } else if (arg == "--output") {
+            options.outputPath = value;
+        } else if (arg == "--format") {
+            std::string format = value;
+            if (format != "csv" && format != "binary") {
+                throw std::invalid_argument("Neizvestnyy format vyvoda: " + format);
+            }
+            options.binaryOutput = (format == "binary");
+        } else if (arg == "--eval") {
+            parseEvalPoints(value, options.evalPoints);
+        } else if (arg == "--threads") {
+            std::size_t threads = parseCountOption(arg, value);
+            if (threads > std::numeric_limits<unsigned>::max()) {
+                throw std::invalid_argument("Neizvestnyy ili nepolnyy parametr: " + arg + " " + value);
+            }
+            options.threads = static_cast<unsigned>(threads);
+        } else if (arg == "--block") {
+            options.blockSize = parseCountOption(arg, value);
+            if (options.blockSize == 0) {
+                throw std::invalid_argument("Razmer bloka dolzhen byt polozhitelnym");
+            }
+        } else if (arg == "--chunk") {
+            options.chunkCapacity = parseCountOption(arg, value);
+            if (options.chunkCapacity == 0) {
+                throw std::invalid_argument("Razmer chanka dolzhen byt polozhitelnym");
+            }
+        } else {
+            throw std::invalid_argument("Neizvestnyy parametr: " + arg);
+        }
+    }
+}
+
+/**
+ * @brief Потоково обрабатывает коэффициенты и выводит результаты
+ * @param options Параметры пакетного режима
+ * @return Код завершения программы
+ * 
+ * @details
+ * Коэффициенты обрабатываются блоками по options.blockSize полиномов: для
+ * блока вычисляются корни и значения в заданных точках, затем результаты
+ * записываются в выходной поток. Текстовый вход читается в буфер одного
+ * блока, поэтому вход любого размера обрабатывается за один проход. Если
+ * входной файл - двоичный файл коэффициентов (см. CoefficientFiles), он
+ * отображается в память и блоки передаются ядрам без разбора и копирования.
+ */
+int runBatchMode(const BatchOptions& options) {
+    const bool mappedInput = options.inputPath != nullptr &&
+                             MappedCoefficientFile::hasSignature(options.inputPath);
+    std::FILE* input = stdin;
+    if (options.inputPath != nullptr && !mappedInput) {
+        input = std::fopen(options.inputPath, "rb");
+        if (input == nullptr) {
+            std::cerr << "Ne udalos otkryt fayl: " << options.inputPath << std::endl;
+            return 1;
+        }
+    }
+    std::FILE* outputFile = stdout;
+    if (options.outputPath != nullptr) {
+        outputFile = std::fopen(options.outputPath, "wb");
+        if (outputFile == nullptr) {
+            std::cerr << "Ne udalos sozdat fayl: " << options.outputPath << std::endl;
+            if (input != stdin) {
+                std::fclose(input);
+            }
+            return 1;
+        }
+    }
+    
+    const std::size_t blockSize = options.blockSize;
+    const std::size_t pointCount = options.evalPoints.size();
+    std::vector<double> root1(blockSize), root2(blockSize);
+    std::vector<int> numRoots(blockSize);
+    std::vector<double> values(blockSize * pointCount);
+    std::vector<double> row(pointCount);
+    
+    ParallelPolynomialSolver solver(options.threads);
+    int status = 0;
+    
+    try {
+        BatchOutput output(outputFile);
+        if (!options.binaryOutput) {
+            output.writeCsvHeader(options.evalPoints);
+        }
+        
+        auto processBlock = [&](const CoefficientSpan& block) {
+            solver.findRoots(block, root1.data(), root2.data(), numRoots.data());
+            for (std::size_t j = 0; j < pointCount; j++) {
+                solver.evaluate(block, options.evalPoints[j], values.data() + j * blockSize);
+            }
+            
+            for (std::size_t i = 0; i < block.count; i++) {
+                for (std::size_t j = 0; j < pointCount; j++) {
+                    row[j] = values[j * blockSize + i];
+                }
+                if (options.binaryOutput) {
+                    output.writeBinaryRecord(block.a[i], block.b[i], block.c[i], numRoots[i],
+                                             root1[i], root2[i], row.data(), pointCount);
+                } else {
+                    output.writeCsvRow(block.a[i], block.b[i], block.c[i], numRoots[i],
+                                       root1[i], root2[i], row.data(), pointCount);
+                }
+            }
+        };
+        
+        if (mappedInput) {
+            MappedCoefficientFile file(options.inputPath);
+            for (std::size_t k = 0; k < file.chunkCount(); k++) {
+                const CoefficientSpan& chunk = file.chunk(k);
+                for (std::size_t begin = 0; begin < chunk.count; begin += blockSize) {
+                    CoefficientSpan block = {chunk.a + begin, chunk.b + begin, chunk.c + begin,
+                                             std::min(blockSize, chunk.count - begin)};
+                    processBlock(block);
+                }
+            }
+        } else {
+            std::vector<double> a(blockSize), b(blockSize), c(blockSize);
+            TextCoefficientReader reader(input);
+            std::size_t n;
+            while ((n = reader.readBlock(a.data(), b.data(), c.data(), blockSize)) > 0) {
+                CoefficientSpan block = {a.data(), b.data(), c.data(), n};
+                processBlock(block);
+            }
+        }
+        output.flush();
+    } catch (const std::exception& e) {
+        std::cerr << "Oshibka: " << e.what() << std::endl;
+        status = 1;
+    }
+    
+    if (input != stdin) {
+        std::fclose(input);
+    }
+    if (outputFile != stdout && std::fclose(outputFile) != 0) {
+        std::cerr << "Oshibka zapisi rezultatov" << std::endl;
+        status = 1;
+    }
+    // stdout может быть занят результатами, поэтому счетчики выводятся в stderr
+    PolynomialStatistics::printPerfCounterSummary(std::cerr);
+    return status;
+}
+
+/**
+ * @brief Преобразует записи "a b c" в двоичный файл коэффициентов
+ * @param options Параметры (используются inputPath, outputPath, blockSize и chunkCapacity)
+ * @return Код завершения программы
+ */
+int runConvertMode(const BatchOptions& options) {
+    if (options.outputPath == nullptr) {
+        std::cerr << "Dlya --convert neobhodim parametr --output" << std::endl;
+        return 1;
+    }
+    std::FILE* input = stdin;
+    if (options.inputPath != nullptr) {
+        input = std::fopen(options.inputPath, "rb");
+        if (input == nullptr) {
+            std::cerr << "Ne udalos otkryt fayl: " << options.inputPath << std::endl;
+            return 1;
+        }
+    }
+    
+    int status = 0;
+    try {
+        CoefficientFileWriter writer(options.outputPath, options.chunkCapacity);
+        TextCoefficientReader reader(input);
+        std::vector<double> a(options.blockSize), b(options.blockSize), c(options.blockSize);
+        std::size_t n;
+        while ((n = reader.readBlock(a.data(), b.data(), c.data(), options.blockSize)) > 0) {
+            writer.append(a.data(), b.data(), c.data(), n);
+        }
+        writer.close();
+    } catch (const std::exception& e) {
+        std::cerr << "Oshibka: " << e.what() << std::endl;
+        status = 1;
+    }
+    
+    if (input != stdin) {
+        std::fclose(input);
+    }
+    return status;
+}
+
+/**
+ * @brief Проверяет ядра корней и вычисления значений всех поддерживаемых наборов инструкций
+ * @return 0, если все варианты совпадают со скалярным кодом, иначе 1
+ * @see countRootKernelMismatches(), countEvaluateKernelMismatches()
+ */
+int runSelfCheckMode() {
+    const KernelIsa detected = detectKernelIsa();
+    const KernelIsa tiers[] = {KernelIsa::avx2, KernelIsa::avx512};
+    int status = 0;
+    for (KernelIsa isa : tiers) {
+        if (isa > detected) {
+            std::cout << kernelIsaName(isa) << ": ne podderzhivaetsya processorom" << std::endl;
+            continue;
+        }
+        std::size_t mismatches = countRootKernelMismatches(isa) + countEvaluateKernelMismatches(isa);
+        std::cout << kernelIsaName(isa) << ": rashozhdeniy so scalar - " << mismatches << std::endl;
+        if (mismatches != 0) {
+            status = 1;
+        }
+    }
+    return status;
+}
+
+/** @} */ // конец группы BatchMode
+
+/**
+ * @defgroup Benchmarks Микробенчмарки
+ * @brief Измерение стоимости основных операций класса полиномов
+ * 
+ * @details
+ * Запускаются параметром --bench. Для каждого замера число итераций
+ * подбирается так, чтобы измерение длилось не меньше заданного времени,
+ * затем выводятся нс/операцию, операций в секунду и выделений памяти на
+ * операцию (текстом или в JSON для сравнения между версиями).
+ * 
+ * Выделения считаются, только если программа собрана с
+ * -DPOLY_BENCH_ALLOCATIONS: тогда глобальные operator new/delete заменяются
+ * счетчиком для всей программы. В обычной сборке распределитель не
+ * меняется, а вместо allocs/op выводится "-" (в JSON - null).
+ * @{
+ */
+
+/**
+ * @brief Счетчик выделений памяти текущего потока
+ * @details Увеличивается замененным глобальным operator new (только при
+ * POLY_BENCH_ALLOCATIONS); счетчик локален для потока, поэтому не создает
+ * разделяемой кэш-линии
+ */
+thread_local std::uint64_t allocationCount = 0;
+
+#if defined(POLY_BENCH_ALLOCATIONS)
+/**
+ * @brief Считаются ли выделения памяти в замерах
+ */
+const bool allocationCounting = true;
+
+/**
+ * @brief Выделяет память с учетом в allocationCount
+ * @param size Размер блока
+ * @param alignment Выравнивание (0 - выравнивание malloc())
+ * @throws std::bad_alloc если память не удалось выделить
+ */
+inline void* countedAllocate(std::size_t size, std::size_t alignment) {
+    allocationCount++;
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        void* memory = (alignment == 0)
+            ? std::malloc(size)
+            : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if (memory != nullptr) {
+            return memory;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* operator new(std::size_t size) {
+    return countedAllocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
 
-// Инициализация статических членов класса Polynomial
-int Polynomial::rootCalculationCount = 0;
-int Polynomial::instanceCount = 0;
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
 
-char** Polynomial::deletedPolynomials = nullptr;
-int Polynomial::deletedCapacity = 0;
-int Polynomial::deletedCount = 0;
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
 
-char** Polynomial::rootCalculations = nullptr;
-int Polynomial::rootCalculationsCapacity = 0;
-int Polynomial::rootCalculationEntries = 0;
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
 
-bool Polynomial::programFinished = false;
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+#else
+const bool allocationCounting = false;
+#endif
 
 /**
- * @defgroup HelperStructures Вспомогательные структуры
- * @brief Структуры для поддержки работы программы
- * @{
+ * @brief Не дает компилятору выбросить вычисление значения
+ * @param value Значение, которое считается использованным
+ */
+template <typename T>
+inline void doNotOptimize(T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @struct BenchmarkResult
+ * @brief Результат одного замера
  */
+struct BenchmarkResult {
+    std::string name;           ///< Название замера
+    std::uint64_t iterations;   ///< Количество измеренных операций
+    double nsPerOp;             ///< Наносекунд на операцию
+    double opsPerSecond;        ///< Операций в секунду
+    double allocsPerOp;         ///< Выделений памяти на операцию (при allocationCounting)
+};
 
 /**
- * @struct PolynomialArray
- * @brief Динамический массив для хранения полиномов
- * 
- * @details
- * Реализует динамический массив с автоматическим управлением памятью.
- * Поддерживает добавление элементов и автоматическое расширение при необходимости.
+ * @class BenchmarkSuite
+ * @brief Запуск замеров и вывод результатов
  */
-struct PolynomialArray {
-    Polynomial* data;   ///< Указатель на массив полиномов
-    int capacity;       ///< Текущая емкость массива
-    int count;          ///< Количество элементов в массиве
-    
+class BenchmarkSuite {
+public:
     /**
-     * @brief Конструктор по умолчанию
-     * @post Инициализирует пустой массив
+     * @brief Конструктор
+     * @param minTimeMs Минимальная длительность одного замера в миллисекундах
+     * @param nameFilter Подстрока названия (пустая - все замеры)
      */
-    PolynomialArray() : data(nullptr), capacity(0), count(0) {}
+    BenchmarkSuite(double minTimeMs, const std::string& nameFilter)
+        : minTime(minTimeMs * 1e-3), filter(nameFilter) {}
     
     /**
-     * @brief Добавляет полином в массив
-     * @param p Полином для добавления
-     * @post Массив автоматически расширяется при необходимости
+     * @brief Выполняет замер
+     * @param name Название замера
+     * @param body Функция, выполняющая одну операцию: body(i), i - номер итерации
+     * 
+     * @details Число итераций удваивается, пока прогон не займет minTime;
+     * в результат идет последний прогон
      */
-    void add(const Polynomial& p) {
-        if (count >= capacity) {
-            int newCapacity = (capacity == 0) ? 2 : capacity * 2;
-            Polynomial* newData = new Polynomial[newCapacity];
-            
-            for (int i = 0; i < count; i++) {
-                newData[i] = data[i];
+    template <typename Body>
+    void run(const std::string& name, Body body) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            return;
+        }
+        
+        std::uint64_t iterations = 1;
+        for (;;) {
+            std::uint64_t allocationsBefore = allocationCount;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (std::uint64_t i = 0; i < iterations; i++) {
+                body(i);
             }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::uint64_t allocations = allocationCount - allocationsBefore;
             
-            delete[] data;
-            data = newData;
-            capacity = newCapacity;
+            if (seconds >= minTime || iterations >= (std::uint64_t(1) << 40)) {
+                BenchmarkResult result;
+                result.name = name;
+                result.iterations = iterations;
+                result.nsPerOp = seconds * 1e9 / static_cast<double>(iterations);
+                result.opsPerSecond = static_cast<double>(iterations) / seconds;
+                result.allocsPerOp = static_cast<double>(allocations) / static_cast<double>(iterations);
+                results.push_back(result);
+                return;
+            }
+            iterations *= 2;
         }
-        
-        data[count] = p;
-        count++;
     }
     
     /**
-     * @brief Очищает массив
-     * @post Освобождает всю занятую память
+     * @brief Выводит результаты таблицей
      */
-    void clear() {
-        delete[] data;
-        data = nullptr;
-        capacity = 0;
-        count = 0;
+    void printText() const {
+        std::printf("kernel isa: %s\n", kernelIsaName(activeKernelIsa));
+        std::printf("%-48s %14s %12s %16s %12s\n", "benchmark", "iterations", "ns/op", "ops/s", "allocs/op");
+        for (const BenchmarkResult& result : results) {
+            std::printf("%-48s %14llu %12.2f %16.0f ", result.name.c_str(),
+                        static_cast<unsigned long long>(result.iterations),
+                        result.nsPerOp, result.opsPerSecond);
+            if (allocationCounting) {
+                std::printf("%12.3f\n", result.allocsPerOp);
+            } else {
+                std::printf("%12s\n", "-");
+            }
+        }
     }
     
     /**
-     * @brief Деструктор
-     * @post Автоматически вызывает clear()
+     * @brief Выводит результаты в JSON
      */
-    ~PolynomialArray() {
-        clear();
+    void printJson() const {
+        std::printf("{\n  \"kernel_isa\": \"%s\",\n  \"benchmarks\": [", kernelIsaName(activeKernelIsa));
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& result = results[i];
+            std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, "
+                        "\"ops_per_second\": %.1f, \"allocs_per_op\": ",
+                        i == 0 ? "" : ",", result.name.c_str(),
+                        static_cast<unsigned long long>(result.iterations),
+                        result.nsPerOp, result.opsPerSecond);
+            if (allocationCounting) {
+                std::printf("%.4f}", result.allocsPerOp);
+            } else {
+                std::printf("null}");
+            }
+        }
+        std::printf("\n  ]\n}\n");
     }
+
+private:
+    double minTime;                         ///< Минимальная длительность замера, с
+    std::string filter;                     ///< Фильтр по названию
+    std::vector<BenchmarkResult> results;   ///< Результаты в порядке выполнения
 };
 
-/** @} */ // конец группы HelperStructures
+/**
+ * @brief Замеры findRoots() по классам корней для полинома с политикой StatsPolicy
+ * @param suite Набор замеров
+ * @param suffix Суффикс названия (политика статистики)
+ */
+template <typename StatsPolicy>
+void benchmarkFindRoots(BenchmarkSuite& suite, const std::string& suffix) {
+    struct RootCase {
+        const char* name;
+        double a, b, c;
+    };
+    static const RootCase cases[] = {
+        {"linear", 0.0, 2.0, -4.0},
+        {"constant", 0.0, 0.0, 5.0},
+        {"two_roots", 1.0, -3.0, 2.0},
+        {"one_root", 1.0, -2.0, 1.0},
+        {"no_roots", 1.0, 0.0, 1.0},
+    };
+    
+    for (const RootCase& rootCase : cases) {
+        BasicPolynomial<StatsPolicy> p(rootCase.a, rootCase.b, rootCase.c);
+        suite.run(std::string("findRoots/") + rootCase.name + "/" + suffix, [&](std::uint64_t) {
+            double root1 = 0.0, root2 = 0.0;
+            int numRoots = 0;
+            doNotOptimize(p);
+            p.findRoots(root1, root2, numRoots);
+            doNotOptimize(root1);
+            doNotOptimize(root2);
+            doNotOptimize(numRoots);
+        });
+    }
+    
+    CachedRoots<BasicPolynomial<StatsPolicy>> cached(BasicPolynomial<StatsPolicy>(1.0, -3.0, 2.0));
+    suite.run("findRoots/cached/" + suffix, [&](std::uint64_t) {
+        double root1 = 0.0, root2 = 0.0;
+        int numRoots = 0;
+        doNotOptimize(cached);
+        cached.findRoots(root1, root2, numRoots);
+        doNotOptimize(root1);
+        doNotOptimize(root2);
+    });
+    suite.run("operator*= then findRoots/" + suffix, [&](std::uint64_t i) {
+        double root1 = 0.0, root2 = 0.0;
+        int numRoots = 0;
+        cached *= (i & 1) ? 2.0 : 0.5;
+        cached.findRoots(root1, root2, numRoots);
+        doNotOptimize(root1);
+        doNotOptimize(root2);
+    });
+}
 
 /**
- * @defgroup HelperFunctions Вспомогательные функции
- * @brief Функции для поддержки работы программы
- * @{
+ * @brief Замеры вычисления значения и арифметических операторов
+ * @param suite Набор замеров
+ * @param suffix Суффикс названия (политика статистики)
  */
+template <typename StatsPolicy>
+void benchmarkOperators(BenchmarkSuite& suite, const std::string& suffix) {
+    typedef BasicPolynomial<StatsPolicy> Poly;
+    Poly p(1.0, -3.0, 2.0);
+    Poly q(0.5, 0.25, -1.0);
+    double scalar = 1.0000001;
+    
+    suite.run("evaluate/" + suffix, [&](std::uint64_t i) {
+        doNotOptimize(p);
+        double value = p.evaluate(static_cast<double>(i & 1023));
+        doNotOptimize(value);
+    });
+    suite.run("operator+=/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(q);
+        p += q;
+        doNotOptimize(p);
+    });
+    suite.run("operator-=/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(q);
+        p -= q;
+        doNotOptimize(p);
+    });
+    suite.run("operator*=/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(scalar);
+        p *= scalar;
+        doNotOptimize(p);
+    });
+    suite.run("operator/=/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(scalar);
+        p /= scalar;
+        doNotOptimize(p);
+    });
+    suite.run("operator++/" + suffix, [&](std::uint64_t) {
+        ++p;
+        doNotOptimize(p);
+    });
+    suite.run("operator--/" + suffix, [&](std::uint64_t) {
+        --p;
+        doNotOptimize(p);
+    });
+    suite.run("operator+ (temporary)/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(p);
+        Poly sum = p + q;
+        doNotOptimize(sum);
+    });
+    suite.run("operator- (temporary)/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(p);
+        Poly difference = p - q;
+        doNotOptimize(difference);
+    });
+    suite.run("operator* (temporary)/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(p);
+        Poly product = p * scalar;
+        doNotOptimize(product);
+    });
+    suite.run("operator/ (temporary)/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(p);
+        Poly quotient = p / scalar;
+        doNotOptimize(quotient);
+    });
+    suite.run("p + q - 3*p (temporaries)/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(p);
+        Poly result = p + q - 3.0 * p;
+        doNotOptimize(result);
+    });
+    suite.run("expr(p) + expr(q) - 3*expr(p) (fused)/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(p);
+        Poly result = expr(p) + expr(q) - 3.0 * expr(p);
+        doNotOptimize(result);
+    });
+    suite.run("operator</" + suffix, [&](std::uint64_t) {
+        doNotOptimize(p);
+        bool less = p < q;
+        doNotOptimize(less);
+    });
+    suite.run("operator==/" + suffix, [&](std::uint64_t) {
+        doNotOptimize(p);
+        bool equal = p == q;
+        doNotOptimize(equal);
+    });
+    suite.run("construct+destroy/" + suffix, [&](std::uint64_t i) {
+        Poly temporary(1.0, static_cast<double>(i & 1023), 2.0);
+        doNotOptimize(temporary);
+    });
+}
 
 /**
- * @brief Выводит корни уравнения в читаемом формате
- * @param root1 Первый корень
- * @param root2 Второй корень
- * @param numRoots Количество корней (0, 1 или 2)
+ * @brief Выполняет все замеры и выводит результаты
+ * @param json true - вывод в JSON, false - таблица
+ * @param minTimeMs Минимальная длительность одного замера в миллисекундах
+ * @param filter Подстрока названия замеров (пустая - все)
+ * @return Код завершения программы
  * 
  * @details
- * Форматированный вывод корней:
- * - 0 корней: "Net deystvitelnyh korney"
- * - 1 корень: "Odin koren: x = value"
- * - 2 корня: "Dva kornya: x1 = value1, x2 = value2"
+ * Операции замеряются для Polynomial (полная статистика, "full") и
+ * PlainPolynomial (без статистики, "plain"); разница construct+destroy
+ * показывает стоимость учета удаления в деструкторе. Накопленная за время
+ * замеров статистика сбрасывается.
  */
-void printRoots(double root1, double root2, int numRoots) {
-    if (numRoots == 0) {
-        std::cout << "Net deystvitelnyh korney" << std::endl;
-    } else if (numRoots == 1) {
-        std::cout << "Odin koren: x = " << root1 << std::endl;
+int runBenchmarks(bool json, double minTimeMs, const std::string& filter) {
+    BenchmarkSuite suite(minTimeMs, filter);
+    
+    benchmarkFindRoots<FullStatistics>(suite, "full");
+    benchmarkFindRoots<NoStatistics>(suite, "plain");
+    
+    // Тот же замер с включенными гистограммами задержек: разница с
+    // findRoots/two_roots/full - стоимость замера (два чтения часов)
+    bool latencyWasTracked = PolynomialStatistics::isLatencyTracking();
+    PolynomialStatistics::setLatencyTracking(true);
+    Polynomial timed(1.0, -3.0, 2.0);
+    suite.run("findRoots/two_roots/full/latency", [&](std::uint64_t) {
+        double root1 = 0.0, root2 = 0.0;
+        int numRoots = 0;
+        doNotOptimize(timed);
+        timed.findRoots(root1, root2, numRoots);
+        doNotOptimize(root1);
+        doNotOptimize(root2);
+    });
+    PolynomialStatistics::setLatencyTracking(latencyWasTracked);
+    
+    RootCache cache;
+    Polynomial cachedFull(1.0, -3.0, 2.0);
+    PlainPolynomial cachedPlain(1.0, -3.0, 2.0);
+    suite.run("RootCache::findRoots/hit/full", [&](std::uint64_t) {
+        double root1 = 0.0, root2 = 0.0;
+        int numRoots = 0;
+        doNotOptimize(cachedFull);
+        cache.findRoots(cachedFull, root1, root2, numRoots);
+        doNotOptimize(root1);
+    });
+    suite.run("RootCache::findRoots/hit/plain", [&](std::uint64_t) {
+        double root1 = 0.0, root2 = 0.0;
+        int numRoots = 0;
+        doNotOptimize(cachedPlain);
+        cache.findRoots(cachedPlain, root1, root2, numRoots);
+        doNotOptimize(root1);
+    });
+    suite.run("RootCache::findRoots/miss/plain", [&](std::uint64_t i) {
+        double root1 = 0.0, root2 = 0.0;
+        int numRoots = 0;
+        PlainPolynomial p(1.0, static_cast<double>(i), -2.0);
+        cache.findRoots(p, root1, root2, numRoots);
+        doNotOptimize(root1);
+    });
+    
+    benchmarkOperators<FullStatistics>(suite, "full");
+    benchmarkOperators<NoStatistics>(suite, "plain");
+    
+    PolynomialArray polynomials;
+    suite.run("PolynomialArray::add (growth)", [&](std::uint64_t i) {
+        // Каждые 65536 элементов массив освобождается, чтобы замер включал рост с нуля
+        if ((i & 0xFFFF) == 0) {
+            polynomials.clear();
+        }
+        polynomials.add(PlainPolynomial(1.0, static_cast<double>(i & 1023), 2.0));
+    });
+    polynomials.clear();
+    
+    std::pmr::monotonic_buffer_resource growthArena;
+    PolynomialArray arenaPolynomials(&growthArena);
+    suite.run("PolynomialArray::add (growth, monotonic arena)", [&](std::uint64_t i) {
+        // Арена освобождается целиком вместе с массивом
+        if ((i & 0xFFFF) == 0) {
+            arenaPolynomials.clear();
+            growthArena.release();
+        }
+        arenaPolynomials.add(PlainPolynomial(1.0, static_cast<double>(i & 1023), 2.0));
+    });
+    arenaPolynomials.clear();
+    
+    const std::size_t sampleCount = 4096;
+    std::vector<double> points(sampleCount), values(sampleCount);
+    for (std::size_t i = 0; i < sampleCount; i++) {
+        points[i] = static_cast<double>(i) * 1e-3;
+        polynomials.add(PlainPolynomial(1.0, points[i], -2.0));
+    }
+    PlainPolynomial sampled(1.0, -3.0, 2.0);
+    suite.run("evaluate x4096 points (scalar loop)", [&](std::uint64_t) {
+        doNotOptimize(sampled);
+        for (std::size_t i = 0; i < sampleCount; i++) {
+            values[i] = sampled.evaluate(points[i]);
+        }
+        doNotOptimize(values[0]);
+    });
+    suite.run("evaluateMany x4096 points", [&](std::uint64_t) {
+        doNotOptimize(sampled);
+        sampled.evaluateMany(points.data(), sampleCount, values.data());
+        doNotOptimize(values[0]);
+    });
+    suite.run("PolynomialTabulator x4096 points", [&](std::uint64_t) {
+        PolynomialTabulator tabulator(sampled, 0.0, 1e-3);
+        tabulator.tabulate(values.data(), sampleCount);
+        doNotOptimize(values[0]);
+    });
+    PolynomialArray combined;
+    suite.run("assign(expr + expr - 3*expr) x4096 polynomials", [&](std::uint64_t) {
+        assign(combined, expr(polynomials) + expr(sampled) - 3.0 * expr(polynomials));
+        doNotOptimize(combined.a[0]);
+    });
+    std::vector<PlainPolynomial> objects;
+    for (std::size_t i = 0; i < sampleCount; i++) {
+        objects.push_back(PlainPolynomial(polynomials.a[i], polynomials.b[i], polynomials.c[i]));
+    }
+    // Множитель скрыт от оптимизатора, иначе умножение на 1 выбрасывается целиком
+    double unitFactor = 1.0;
+    suite.run("operator*= loop x4096 Polynomial", [&](std::uint64_t) {
+        doNotOptimize(unitFactor);
+        for (PlainPolynomial& p : objects) {
+            p *= unitFactor;
+        }
+        doNotOptimize(objects[0]);
+    });
+    suite.run("PolynomialArray::operator*= x4096", [&](std::uint64_t) {
+        doNotOptimize(unitFactor);
+        polynomials *= unitFactor;
+        doNotOptimize(polynomials.a[0]);
+    });
+    assign(combined, expr(polynomials));
+    suite.run("PolynomialArray::operator+= x4096", [&](std::uint64_t) {
+        combined += polynomials;
+        doNotOptimize(combined.a[0]);
+    });
+    std::vector<double> divisors(sampleCount, 1.0);
+    std::vector<unsigned char> divisionErrors(sampleCount);
+    divisors[sampleCount / 2] = 0.0;
+    suite.run("PolynomialArray::divide x4096", [&](std::uint64_t) {
+        std::size_t errors = polynomials.divide(divisors.data(), divisionErrors.data());
+        doNotOptimize(errors);
+    });
+    suite.run("evaluateMany x4096 polynomials", [&](std::uint64_t i) {
+        evaluateMany(polynomials.span(), static_cast<double>(i & 1023), values.data());
+        doNotOptimize(values[0]);
+    });
+    
+    // Точность: те же коэффициенты в double, float и float с корнями в double
+    FloatPolynomialArray floatPolynomials;
+    for (std::size_t i = 0; i < sampleCount; i++) {
+        floatPolynomials.emplace(static_cast<float>(polynomials.a[i]), static_cast<float>(polynomials.b[i]),
+                                 static_cast<float>(polynomials.c[i]));
+    }
+    std::vector<double> root1(sampleCount), root2(sampleCount);
+    std::vector<float> floatRoot1(sampleCount), floatRoot2(sampleCount);
+    std::vector<int> rootCounts(sampleCount);
+    suite.run("PolynomialArray::findRoots x4096 (double)", [&](std::uint64_t) {
+        polynomials.findRoots(root1.data(), root2.data(), rootCounts.data());
+        doNotOptimize(root1[0]);
+    });
+    suite.run("FloatPolynomialArray::findRoots x4096 (float)", [&](std::uint64_t) {
+        floatPolynomials.findRoots(floatRoot1.data(), floatRoot2.data(), rootCounts.data());
+        doNotOptimize(floatRoot1[0]);
+    });
+    suite.run("FloatPolynomialArray::findRoots x4096 (mixed)", [&](std::uint64_t) {
+        floatPolynomials.findRoots(root1.data(), root2.data(), rootCounts.data());
+        doNotOptimize(root1[0]);
+    });
+    
+    // Случайные знаки дискриминанта: ветвящийся solveQuadratic против выбора по маске
+    PolynomialArray mixedSigns;
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = 0; i < sampleCount; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        mixedSigns.emplace(1.0, static_cast<double>(state >> 60), static_cast<double>((state >> 40) & 31));
+    }
+    std::vector<double> imag1(sampleCount), imag2(sampleCount);
+    suite.run("solveQuadratic loop x4096 (random sign)", [&](std::uint64_t) {
+        for (std::size_t i = 0; i < sampleCount; i++) {
+            PlainPolynomial::solveQuadratic(mixedSigns.a[i], mixedSigns.b[i], mixedSigns.c[i],
+                                            root1[i], root2[i], rootCounts[i]);
+        }
+        doNotOptimize(root1[0]);
+    });
+    suite.run("solveQuadraticComplex loop x4096 (random sign)", [&](std::uint64_t) {
+        for (std::size_t i = 0; i < sampleCount; i++) {
+            ComplexRootPair<double> pair = PlainPolynomial::solveQuadraticComplex(
+                mixedSigns.a[i], mixedSigns.b[i], mixedSigns.c[i]);
+            root1[i] = pair.real1;
+            imag1[i] = pair.imag1;
+            root2[i] = pair.real2;
+            imag2[i] = pair.imag2;
+        }
+        doNotOptimize(root1[0]);
+    });
+    suite.run("findComplexRoots x4096 (random sign)", [&](std::uint64_t) {
+        mixedSigns.findComplexRoots(root1.data(), imag1.data(), root2.data(), imag2.data());
+        doNotOptimize(root1[0]);
+    });
+    
+    // Сортировка: каждое сравнение operator< против ключа, вычисляемого один раз
+    std::vector<PlainPolynomial> unsorted, sorted;
+    for (std::size_t i = 0; i < sampleCount; i++) {
+        unsorted.push_back(PlainPolynomial(polynomials.b[(i * 2654435761u) % sampleCount], 1.0, -2.0));
+    }
+    suite.run("std::sort operator< x4096", [&](std::uint64_t) {
+        sorted = unsorted;
+        std::sort(sorted.begin(), sorted.end());
+        doNotOptimize(sorted[0]);
+    });
+    PolynomialArray sortable;
+    suite.run("sortPolynomials x4096", [&](std::uint64_t) {
+        sortable.count = 0;
+        for (const PlainPolynomial& p : unsorted) {
+            sortable.add(p);
+        }
+        sortPolynomials(sortable);
+        doNotOptimize(sortable.a[0]);
+    });
+    polynomials.clear();
+    
+    if (json) {
+        suite.printJson();
     } else {
-        std::cout << "Dva kornya: x1 = " << root1 << ", x2 = " << root2 << std::endl;
+        suite.printText();
     }
+    
+    Polynomial::resetStatistics();
+    return 0;
 }
 
 /**
- * @brief Тестирует все операции для заданного полинома
- * @param p Полином для тестирования
- * @return true - вернуться в главное меню, false - продолжить тестирование
- * 
- * @details
- * Предоставляет интерактивное меню для тестирования:
- * 1. Унарные операции (++, --)
- * 2. Бинарные операции (+, -, *, /)
- * 3. Операции сравнения
- * 4. Нахождение корней
- * 5. Вычисление значения
- * 6. Вернуться к выбору полинома
- * 7. Вернуться в главное меню
+ * @brief Разбирает параметры режима --bench и выполняет замеры
+ * @param argc Количество аргументов
+ * @param argv Аргументы командной строки (параметры начинаются с argv[2])
+ * @return Код завершения программы
  */
-bool testAllOperations(Polynomial& p) {
-    std::cout << "\n----- Test vseh operaciy dlya polynoma: ";
-    p.print();
-    std::cout << " -----" << std::endl;
-    
-    Polynomial original_p = p;
-    
-    int testChoice;
-    do {
-        std::cout << "\nViberite operaciyu:" << std::endl;
-        std::cout << "1. Unarnye operacii (++, --)" << std::endl;
-        std::cout << "2. Binarnye operacii (+, -, *, /)" << std::endl;
-        std::cout << "3. Operacii sravneniya (<, >, ==, !=)" << std::endl;
-        std::cout << "4. Nahozhdenie korney" << std::endl;
-        std::cout << "5. Vychislit znachenie" << std::endl;
-        std::cout << "6. Vernutsya k viboru polynoma" << std::endl;
-        std::cout << "7. Vernutsya v glavnoe menu" << std::endl;
-        std::cout << "Vash vibor: ";
-        std::cin >> testChoice;
-        
-        if (testChoice == 1) {
-            std::cout << "\n--- Unarnye operacii ---" << std::endl;
-            std::cout << "Tekushiy polynom: ";
-            p.print();
-            std::cout << std::endl;
-            
-            std::cout << "\n1. ++p (prefix increment)" << std::endl;
-            std::cout << "   Do: "; p.print(); std::cout << std::endl;
-            Polynomial& result_pre_inc = ++p;
-            std::cout << "   Posle ++p: "; p.print(); std::cout << std::endl;
-            std::cout << "   Rezultat (ssylka): "; result_pre_inc.print(); std::cout << std::endl;
-            
-            std::cout << "\n2. p++ (postfix increment)" << std::endl;
-            std::cout << "   Do: "; p.print(); std::cout << std::endl;
-            Polynomial result_post_inc = p++;
-            std::cout << "   Posle p++: "; p.print(); std::cout << std::endl;
-            std::cout << "   Rezultat (kopiya): "; result_post_inc.print(); std::cout << std::endl;
-            
-            std::cout << "\n3. --p (prefix decrement)" << std::endl;
-            std::cout << "   Do: "; p.print(); std::cout << std::endl;
-            Polynomial& result_pre_dec = --p;
-            std::cout << "   Posle --p: "; p.print(); std::cout << std::endl;
-            std::cout << "   Rezultat (ssylka): "; result_pre_dec.print(); std::cout << std::endl;
-            
-            std::cout << "\n4. p-- (postfix decrement)" << std::endl;
-            std::cout << "   Do: "; p.print(); std::cout << std::endl;
-            Polynomial result_post_dec = p--;
-            std::cout << "   Posle p--: "; p.print(); std::cout << std::endl;
-            std::cout << "   Rezultat (kopiya): "; result_post_dec.print(); std::cout << std::endl;
-            
-            p = original_p;
-            
-        } else if (testChoice == 2) {
-            std::cout << "\n--- Binarnye operacii ---" << std::endl;
-            
-            std::cout << "Vvedite vtoroy polynom (a b c): ";
-            double a, b, c;
-            std::cin >> a >> b >> c;
-            Polynomial other(a, b, c);
-            
-            std::cout << "\nOperacii s polynomami:" << std::endl;
-            std::cout << "p1: "; p.print(); std::cout << std::endl;
-            std::cout << "p2: "; other.print(); std::cout << std::endl;
-            
-            std::cout << "\n1. p1 + p2 = "; (p + other).print(); std::cout << std::endl;
-            std::cout << "2. p1 - p2 = "; (p - other).print(); std::cout << std::endl;
-            
-            double scalar;
-            std::cout << "\nVvedite chislo dlya umnozheniya/deleniya: ";
-            std::cin >> scalar;
-            
-            std::cout << "3. p1 * " << scalar << " = "; (p * scalar).print(); std::cout << std::endl;
-            std::cout << "4. " << scalar << " * p1 = "; (scalar * p).print(); std::cout << std::endl;
-            
-            if (scalar != 0) {
-                std::cout << "5. p1 / " << scalar << " = "; (p / scalar).print(); std::cout << std::endl;
-            } else {
-                std::cout << "5. p1 / 0 = Nelzya delit na nol!" << std::endl;
-            }
-            
-        } else if (testChoice == 3) {
-            std::cout << "\n--- Operacii sravneniya ---" << std::endl;
-            
-            std::cout << "Vvedite vtoroy polynom (a b c): ";
-            double a, b, c;
-            std::cin >> a >> b >> c;
-            Polynomial other(a, b, c);
-            
-            double x = 2.0;
-            
-            std::cout << "\nSravnenie polynomov pri x = " << x << ":" << std::endl;
-            std::cout << "p1: "; p.print(); 
-            std::cout << " = " << p.evaluate(x) << std::endl;
-            std::cout << "p2: "; other.print(); 
-            std::cout << " = " << other.evaluate(x) << std::endl;
-            
-            std::cout << "\nRezultaty sravneniya:" << std::endl;
-            
-            double val1 = p.evaluate(x);
-            double val2 = other.evaluate(x);
-            
-            std::cout << "p1 < p2: " << (p < other ? "DA" : "NET") << std::endl;
-            std::cout << "p1 > p2: " << (p > other ? "DA" : "NET") << std::endl;
-            std::cout << "p1 <= p2: " << (p <= other ? "DA" : "NET") << std::endl;
-            std::cout << "p1 >= p2: " << (p >= other ? "DA" : "NET") << std::endl;
-            std::cout << "p1 == p2: " << (p == other ? "DA" : "NET") << std::endl;
-            std::cout << "p1 != p2: " << (p != other ? "DA" : "NET") << std::endl;
-            
-            std::cout << "\nItog:" << std::endl;
-            if (val1 > val2) {
-                std::cout << "p1 > p2" << std::endl;
-            } else if (val1 < val2) {
-                std::cout << "p1 < p2" << std::endl;
-            } else {
-                std::cout << "p1 = p2" << std::endl;
+int runBenchmarkMode(int argc, char* argv[]) {
+    bool json = false;
+    double minTimeMs = 200.0;
+    std::string filter;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            const char* value = argv[++i];
+            char* parsedEnd = nullptr;
+            minTimeMs = std::strtod(value, &parsedEnd);
+            if (parsedEnd == value || *parsedEnd != '\0' || !(minTimeMs >= 0.0 && minTimeMs <= 1e9)) {
+                std::cerr << "Nekorrektnoe znachenie --min-time: " << value << std::endl;
+                printUsage(argv[0]);
+                return 1;
             }
-            
-        } else if (testChoice == 4) {
-            std::cout << "\n--- Nahozhdenie korney ---" << std::endl;
-            std::cout << "Polynom: "; p.print(); std::cout << std::endl;
-            
-            double root1, root2;
-            int numRoots;
-            p.findRoots(root1, root2, numRoots);
-            std::cout << "Korni: ";
-            printRoots(root1, root2, numRoots);
-            
-        } else if (testChoice == 5) {
-            std::cout << "\n--- Vychislenie znacheniya ---" << std::endl;
-            double x;
-            std::cout << "Vvedite x: ";
-            std::cin >> x;
-            std::cout << "p(" << x << ") = " << p.evaluate(x) << std::endl;
-            
-        } else if (testChoice == 6) {
-            std::cout << "Vozvrashchenie k viboru polynoma..." << std::endl;
-            p = original_p;
-            return false;
-            
-        } else if (testChoice == 7) {
-            std::cout << "Vozvrashenie v glavnoe menu..." << std::endl;
-            p = original_p;
-            return true;
-            
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
         } else {
-            std::cout << "Nekorrektny vibor!" << std::endl;
+            std::cerr << "Neizvestnyy ili nepolnyy parametr: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
         }
-        
-    } while (true);
+    }
+    return runBenchmarks(json, minTimeMs, filter);
 }
 
-/** @} */ // конец группы HelperFunctions
+/** @} */ // конец группы Benchmarks
 
 /**
  * @brief Главная функция программы
+ * @param argc Количество аргументов командной строки
+ * @param argv Аргументы командной строки
  * @return 0 при успешном завершении
  * 
  * @details
- * Реализует интерактивное меню:
+ * С параметром --batch работает в пакетном режиме (см. runBatchMode()),
+ * с --convert преобразует текстовые коэффициенты в двоичный файл
+ * (см. runConvertMode()), с --bench выполняет замеры (см. runBenchmarks()).
+ * Без параметров реализует интерактивное меню:
  * 1. Создать полином (ручной ввод)
  * 2. Протестировать все операции
  * 3. Узнать статистику вычисления корней
@@ -998,10 +8499,36 @@ bool testAllOperations(Polynomial& p) {
  * 
  * При выходе автоматически выводится статистика и очищается память.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        std::string mode = argv[1];
+        if (mode == "--bench") {
+            return runBenchmarkMode(argc, argv);
+        }
+        if (mode == "--selfcheck") {
+            return runSelfCheckMode();
+        }
+        if (mode != "--batch" && mode != "--convert") {
+            printUsage(argv[0]);
+            return (mode == "--help") ? 0 : 1;
+        }
+        
+        BatchOptions options;
+        try {
+            parseBatchOptions(argc, argv, options);
+        } catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        return (mode == "--convert") ? runConvertMode(options) : runBatchMode(options);
+    }
+    
     std::cout << "=== Quadratic Polynomial Calculator ===" << std::endl;
     
-    PolynomialArray polynomials;
+    // Массив живет всю сессию: его колонки берутся из арены сессии и
+    // возвращаются вместе с ней в cleanupStaticData()
+    PolynomialArray polynomials(Polynomial::sessionResource());
     
     int choice;
     do {
@@ -1027,7 +8554,7 @@ int main() {
             if (constrChoice == 1) {
                 polynomials.add(Polynomial());
                 std::cout << "\nSozdan polynom: ";
-                polynomials.data[polynomials.count - 1].print();
+                polynomials.view(polynomials.count - 1).print();
                 std::cout << std::endl;
                 
             } else if (constrChoice == 2) {
@@ -1037,7 +8564,7 @@ int main() {
                 
                 polynomials.add(Polynomial(c));
                 std::cout << "\nSozdan polynom: ";
-                polynomials.data[polynomials.count - 1].print();
+                polynomials.view(polynomials.count - 1).print();
                 std::cout << std::endl;
                 
             } else if (constrChoice == 3) {
@@ -1051,7 +8578,7 @@ int main() {
                 
                 polynomials.add(Polynomial(a, b, c));
                 std::cout << "\nSozdan polynom: ";
-                polynomials.data[polynomials.count - 1].print();
+                polynomials.view(polynomials.count - 1).print();
                 std::cout << std::endl;
             }
             
@@ -1070,13 +8597,13 @@ int main() {
                 std::cout << "\nViberite polynom dlya testirovaniya:" << std::endl;
                 std::cout << "1. Vvesti novyy polynom" << std::endl;
                 
-                for (int i = 0; i < polynomials.count; i++) {
+                for (std::size_t i = 0; i < polynomials.count; i++) {
                     std::cout << i+2 << ". ";
-                    polynomials.data[i].print();
+                    polynomials.view(i).print();
                     std::cout << std::endl;
                 }
                 
-                int lastOption = polynomials.count + 2;
+                int lastOption = static_cast<int>(polynomials.count) + 2;
                 std::cout << lastOption << ". Vernutsya v glavnoe menu" << std::endl;
                 
                 std::cout << "\nVash vibor: ";
@@ -1094,17 +8621,21 @@ int main() {
                     
                     polynomials.add(Polynomial(a, b, c));
                     std::cout << "\nSozdan novyy polynom: ";
-                    polynomials.data[polynomials.count - 1].print();
+                    polynomials.view(polynomials.count - 1).print();
                     std::cout << std::endl;
                     
-                    bool backToMain = testAllOperations(polynomials.data[polynomials.count - 1]);
+                    PolynomialView selected = polynomials.view(polynomials.count - 1);
+                    bool backToMain = testAllOperations(selected);
+                    polynomials.set(polynomials.count - 1, selected);
                     
                     if (backToMain) {
                         break;
                     }
                 }
-                else if (polyChoice >= 2 && polyChoice <= polynomials.count + 1) {
-                    bool backToMain = testAllOperations(polynomials.data[polyChoice - 2]);
+                else if (polyChoice >= 2 && polyChoice < lastOption) {
+                    PolynomialView selected = polynomials.view(polyChoice - 2);
+                    bool backToMain = testAllOperations(selected);
+                    polynomials.set(polyChoice - 2, selected);
                     if (backToMain) {
                         break;
                     }
@@ -1132,6 +8663,10 @@ int main() {
             
             polynomials.clear();
             
+            // Колонки не содержат объектов Polynomial, поэтому финальная
+            // статистика не будет выведена деструктором и выводится явно
+            Polynomial::printFinalStatistics();
+            
             Polynomial::cleanupStaticData();
             
             std::cout << "\nProgramma zavershaet rabotu." << std::endl;